@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RetargetAssetIndex.h"
+#include "Modules/ModuleManager.h"
+#include "AssetRegistryModule.h"
+#include "Animation/Skeleton.h"
+#include "Animation/AnimationAsset.h"
+#include "Animation/AnimBlueprint.h"
+#include "Engine/SkeletalMesh.h"
+
+TUniquePtr<FRetargetAssetIndex> FRetargetAssetIndex::Instance;
+
+FRetargetAssetIndex& FRetargetAssetIndex::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = TUniquePtr<FRetargetAssetIndex>(new FRetargetAssetIndex());
+	}
+
+	Instance->BuildIfNeeded();
+	return *Instance;
+}
+
+void FRetargetAssetIndex::Shutdown()
+{
+	Instance.Reset();
+}
+
+FRetargetAssetIndex::~FRetargetAssetIndex()
+{
+	if (bBuilt && FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.OnAssetAdded().Remove(OnAssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(OnAssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(OnAssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(OnAssetUpdatedHandle);
+	}
+}
+
+FName FRetargetAssetIndex::GetRigKey(const FString& RigFullName)
+{
+	return RigFullName.IsEmpty() ? NAME_None : FName(*RigFullName);
+}
+
+FName FRetargetAssetIndex::GetSkeletonRig(FName SkeletonObjectPath)
+{
+	const FName* RigKey = SkeletonToRig.Find(SkeletonObjectPath);
+	return RigKey ? *RigKey : NAME_None;
+}
+
+FName FRetargetAssetIndex::GetSkeletonKey(const USkeleton* Skeleton)
+{
+	return Skeleton ? FName(*FAssetData(Skeleton).GetExportTextName()) : NAME_None;
+}
+
+void FRetargetAssetIndex::GetAnimationAssetsForSkeleton(FName SkeletonKey, TArray<FAssetData>& OutAssets)
+{
+	if (const TSet<FName>* ObjectPaths = SkeletonToAnimationAssets.Find(SkeletonKey))
+	{
+		// one registry query for the whole skeleton
+		FARFilter Filter;
+		Filter.ObjectPaths = ObjectPaths->Array();
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.GetAssets(Filter, OutAssets);
+	}
+}
+
+ERetargetReferencerKind FRetargetAssetIndex::ClassifyReferencer(FName PackageName, FAssetData& OutAssetData)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> PackageAssets;
+	AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+
+	for (const FAssetData& AssetData : PackageAssets)
+	{
+		UClass* AssetClass = AssetData.GetClass();
+		if (!AssetClass)
+		{
+			continue;
+		}
+
+		// we only care animation asset or animation blueprint
+		if (AssetClass->IsChildOf(UAnimationAsset::StaticClass()) || AssetClass->IsChildOf(UAnimBlueprint::StaticClass()))
+		{
+			OutAssetData = AssetData;
+			return ERetargetReferencerKind::Animation;
+		}
+		else if (AssetClass->IsChildOf(USkeletalMesh::StaticClass()))
+		{
+			return ERetargetReferencerKind::SkeletalMesh;
+		}
+	}
+
+	return ERetargetReferencerKind::Unrelated;
+}
+
+void FRetargetAssetIndex::BuildIfNeeded()
+{
+	if (bBuilt)
+	{
+		return;
+	}
+
+	bBuilt = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// assets still being discovered will come through OnAssetAdded
+	TArray<FAssetData> SkeletonAssets;
+	AssetRegistry.GetAssetsByClass(USkeleton::StaticClass()->GetFName(), SkeletonAssets, true);
+	for (const FAssetData& AssetData : SkeletonAssets)
+	{
+		AddSkeleton(AssetData);
+	}
+
+	TArray<FAssetData> AnimationAssets;
+	AssetRegistry.GetAssetsByClass(UAnimationAsset::StaticClass()->GetFName(), AnimationAssets, true);
+	for (const FAssetData& AssetData : AnimationAssets)
+	{
+		AddAnimationAsset(AssetData);
+	}
+
+	OnAssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FRetargetAssetIndex::OnAssetAdded);
+	OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FRetargetAssetIndex::OnAssetRemoved);
+	OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FRetargetAssetIndex::OnAssetRenamed);
+	OnAssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FRetargetAssetIndex::OnAssetUpdated);
+}
+
+void FRetargetAssetIndex::AddSkeleton(const FAssetData& AssetData)
+{
+	RemoveSkeleton(AssetData.ObjectPath);
+
+	const FName RigKey = GetRigKey(AssetData.GetTagValueRef<FString>(USkeleton::RigTag));
+	if (RigKey != NAME_None)
+	{
+		SkeletonToRig.Add(AssetData.ObjectPath, RigKey);
+	}
+}
+
+void FRetargetAssetIndex::RemoveSkeleton(FName SkeletonObjectPath)
+{
+	SkeletonToRig.Remove(SkeletonObjectPath);
+}
+
+void FRetargetAssetIndex::AddAnimationAsset(const FAssetData& AssetData)
+{
+	RemoveAnimationAsset(AssetData.ObjectPath);
+
+	const FName SkeletonKey = FName(*AssetData.GetTagValueRef<FString>(TEXT("Skeleton")));
+	if (SkeletonKey != NAME_None)
+	{
+		SkeletonToAnimationAssets.FindOrAdd(SkeletonKey).Add(AssetData.ObjectPath);
+		AnimationAssetToSkeleton.Add(AssetData.ObjectPath, SkeletonKey);
+	}
+}
+
+void FRetargetAssetIndex::RemoveAnimationAsset(FName AssetObjectPath)
+{
+	FName SkeletonKey;
+	if (AnimationAssetToSkeleton.RemoveAndCopyValue(AssetObjectPath, SkeletonKey))
+	{
+		if (TSet<FName>* Assets = SkeletonToAnimationAssets.Find(SkeletonKey))
+		{
+			Assets->Remove(AssetObjectPath);
+			if (Assets->Num() == 0)
+			{
+				SkeletonToAnimationAssets.Remove(SkeletonKey);
+			}
+		}
+	}
+}
+
+bool FRetargetAssetIndex::IsAnimationAsset(const FAssetData& AssetData)
+{
+	UClass* AssetClass = AssetData.GetClass();
+	return AssetClass && AssetClass->IsChildOf(UAnimationAsset::StaticClass());
+}
+
+void FRetargetAssetIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.AssetClass == USkeleton::StaticClass()->GetFName())
+	{
+		AddSkeleton(AssetData);
+	}
+	else if (IsAnimationAsset(AssetData))
+	{
+		AddAnimationAsset(AssetData);
+	}
+}
+
+void FRetargetAssetIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (AssetData.AssetClass == USkeleton::StaticClass()->GetFName())
+	{
+		RemoveSkeleton(AssetData.ObjectPath);
+	}
+	else
+	{
+		RemoveAnimationAsset(AssetData.ObjectPath);
+	}
+}
+
+void FRetargetAssetIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (AssetData.AssetClass == USkeleton::StaticClass()->GetFName())
+	{
+		RemoveSkeleton(FName(*OldObjectPath));
+		AddSkeleton(AssetData);
+	}
+	else if (IsAnimationAsset(AssetData))
+	{
+		RemoveAnimationAsset(FName(*OldObjectPath));
+		AddAnimationAsset(AssetData);
+	}
+}
+
+void FRetargetAssetIndex::OnAssetUpdated(const FAssetData& AssetData)
+{
+	OnAssetAdded(AssetData);
+}
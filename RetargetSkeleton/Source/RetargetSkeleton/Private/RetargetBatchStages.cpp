@@ -0,0 +1,560 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RetargetBatchStages.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "HAL/FileManager.h"
+#include "Animation/Skeleton.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/AnimDataModel.h"
+#include "Animation/AnimData/AnimDataController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "UObject/UObjectIterator.h"
+#include "Containers/Ticker.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "HAL/IConsoleManager.h"
+#include "Animation/AnimBlueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "PackageTools.h"
+#include "HAL/PlatformMemory.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
+
+DEFINE_LOG_CATEGORY(LogRetargetSkeleton);
+
+#define LOCTEXT_NAMESPACE "RetargetBatchStages"
+
+static TAutoConsoleVariable<int32> CVarFlushEveryAssets(
+	TEXT("RetargetSkeleton.FlushEveryAssets"),
+	0,
+	TEXT("When above 0, skeleton retarget saves, unloads and garbage collects the assets it retargeted every this many assets."));
+
+static TAutoConsoleVariable<int32> CVarFlushAboveResidentMB(
+	TEXT("RetargetSkeleton.FlushAboveResidentMB"),
+	0,
+	TEXT("When above 0, skeleton retarget saves, unloads and garbage collects the assets it retargeted once the editor uses more physical memory than this."));
+
+static TAutoConsoleVariable<int32> CVarMinAssetsBeforeFlush(
+	TEXT("RetargetSkeleton.MinPageSize"),
+	16,
+	TEXT("Number of assets skeleton retarget loads before RetargetSkeleton.FlushAboveResidentMB can end a page or chunk, so an editor already over the limit still makes progress."));
+
+static TAutoConsoleVariable<bool> CVarTransferVirtualBones(
+	TEXT("RetargetSkeleton.TransferVirtualBones"),
+	false,
+	TEXT("Whether skeleton retarget also copies virtual bones missing on the new skeleton, next to sockets."));
+
+namespace RetargetBatchStages
+{
+	FMemoryBudget FMemoryBudget::FromConsoleVariables()
+	{
+		FMemoryBudget Budget;
+		Budget.FlushEveryAssets = FMath::Max(CVarFlushEveryAssets.GetValueOnGameThread(), 0);
+		Budget.FlushAboveResidentBytes = (uint64)FMath::Max(CVarFlushAboveResidentMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+		Budget.MinAssetsBeforeFlush = FMath::Max(CVarMinAssetsBeforeFlush.GetValueOnGameThread(), 1);
+		return Budget;
+	}
+
+	bool FMemoryBudget::IsOverResidentLimit() const
+	{
+		return FlushAboveResidentBytes > 0 && FPlatformMemory::GetStats().UsedPhysical > FlushAboveResidentBytes;
+	}
+
+	int32 ReleasePackages(const TArray<UPackage*>& Packages)
+	{
+		TArray<UPackage*> PackagesToUnload;
+		for (UPackage* Package : Packages)
+		{
+			// unsaved changes must not be lost, and blueprint classes may still have live instances
+			if (Package && !Package->IsDirty() && !FindObjectWithOuter(Package, UAnimBlueprint::StaticClass()))
+			{
+				PackagesToUnload.Add(Package);
+			}
+		}
+
+		if (PackagesToUnload.Num() == 0)
+		{
+			return 0;
+		}
+
+		const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+		// unloading collects garbage itself
+		FText ErrorMessage;
+		if (!UPackageTools::UnloadPackages(PackagesToUnload, ErrorMessage))
+		{
+			UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to unload retargeted packages: %s"), *ErrorMessage.ToString());
+		}
+
+		const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Released %d packages, resident memory %.1f MB -> %.1f MB"),
+			PackagesToUnload.Num(), UsedBefore / (1024.0 * 1024.0), UsedAfter / (1024.0 * 1024.0));
+
+		return PackagesToUnload.Num();
+	}
+
+	/** Skeletons waiting for their components to be refreshed, and the ticker that will do it */
+	static TSet<TWeakObjectPtr<USkeleton>> PendingRefreshSkeletons;
+	static FTSTicker::FDelegateHandle PendingRefreshHandle;
+
+	static bool RefreshPendingComponents(float DeltaTime)
+	{
+		PendingRefreshHandle.Reset();
+
+		TSet<USkeleton*> Skeletons;
+		for (const TWeakObjectPtr<USkeleton>& Skeleton : PendingRefreshSkeletons)
+		{
+			if (Skeleton.IsValid())
+			{
+				Skeletons.Add(Skeleton.Get());
+			}
+		}
+		PendingRefreshSkeletons.Reset();
+
+		if (Skeletons.Num() == 0)
+		{
+			return false;
+		}
+
+		// one pass over the loaded components for the whole selection
+		TMap<USkeleton*, TArray<USkeletalMeshComponent*>> ComponentsBySkeleton;
+		for (TObjectIterator<USkeletalMeshComponent> It; It; ++It)
+		{
+			USkeletalMeshComponent* MeshComponent = *It;
+			USkeleton* Skeleton = MeshComponent->SkeletalMesh ? MeshComponent->SkeletalMesh->GetSkeleton() : nullptr;
+			if (Skeleton && Skeletons.Contains(Skeleton))
+			{
+				ComponentsBySkeleton.FindOrAdd(Skeleton).Add(MeshComponent);
+			}
+		}
+
+		for (const TPair<USkeleton*, TArray<USkeletalMeshComponent*>>& Pair : ComponentsBySkeleton)
+		{
+			for (USkeletalMeshComponent* MeshComponent : Pair.Value)
+			{
+				MeshComponent->InitAnim(true);
+			}
+
+			UE_LOG(LogRetargetSkeleton, Log, TEXT("Refreshed %d components using %s"), Pair.Value.Num(), *Pair.Key->GetName());
+		}
+
+		return false;
+	}
+
+	bool SavePackages(const TArray<UPackage*>& Packages, TArray<UPackage*>* OutFailedPackages)
+	{
+		if (Packages.Num() == 0)
+		{
+			return true;
+		}
+
+		// the engine doesn't allow concurrent serialization in the editor, so packages are serialized one by one
+		// and only the file writes are handed off with SAVE_Async
+		FScopedSlowTask Progress(Packages.Num(), LOCTEXT("SavingPackages", "Saving retargeted packages..."));
+		Progress.MakeDialog();
+
+		const double StartTime = FPlatformTime::Seconds();
+		double SerializeSeconds = 0.0;
+
+		TArray<FString> SavedFilenames;
+		TArray<FString> NewFilenames;
+		int32 NumFailed = 0;
+
+		for (UPackage* Package : Packages)
+		{
+			Progress.EnterProgressFrame(1.f);
+
+			if (!Package)
+			{
+				continue;
+			}
+
+			const FString PackageName = Package->GetName();
+			const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+
+			// duplicates and copies for additional targets are written for the first time
+			const bool bNewFile = !IFileManager::Get().FileExists(*PackageFileName);
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Standalone;
+			SaveArgs.Error = GWarn;
+			SaveArgs.bWarnOfLongFilename = true;
+			SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+
+			const double PackageStartTime = FPlatformTime::Seconds();
+			const bool bSaved = UPackage::SavePackage(Package, NULL, *PackageFileName, SaveArgs);
+			const double PackageSeconds = FPlatformTime::Seconds() - PackageStartTime;
+			SerializeSeconds += PackageSeconds;
+
+			if (bSaved)
+			{
+				SavedFilenames.Add(PackageFileName);
+				if (bNewFile)
+				{
+					NewFilenames.Add(PackageFileName);
+				}
+				UE_LOG(LogRetargetSkeleton, Verbose, TEXT("Serialized %s in %.2f ms"), *PackageName, PackageSeconds * 1000.0);
+			}
+			else
+			{
+				++NumFailed;
+				if (OutFailedPackages)
+				{
+					OutFailedPackages->Add(Package);
+				}
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to save %s"), *PackageName);
+			}
+		}
+
+		// flush the writes still in flight before anyone touches the files
+		UPackage::WaitForAsyncFileWrites();
+
+		// new files are not known to source control yet
+		if (NewFilenames.Num() > 0 && ISourceControlModule::Get().IsEnabled())
+		{
+			if (!USourceControlHelpers::MarkFilesForAdd(NewFilenames, true))
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to mark %d new packages for add in source control"), NewFilenames.Num());
+			}
+		}
+
+		const double TotalSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, SMALL_NUMBER);
+
+		int64 TotalBytes = 0;
+		for (const FString& Filename : SavedFilenames)
+		{
+			TotalBytes += FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+		}
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Saved %d packages (%d failed) in %.2f s, %.2f s serializing, %.1f packages/s, %.2f MB/s"),
+			SavedFilenames.Num(), NumFailed, TotalSeconds, SerializeSeconds,
+			SavedFilenames.Num() / TotalSeconds, (TotalBytes / (1024.0 * 1024.0)) / TotalSeconds);
+
+		return NumFailed == 0;
+	}
+
+	int32 AddCurveNamesToSkeleton(USkeleton* Skeleton, const FName& ContainerName, const TSet<FName>& CurveNames)
+	{
+		// only names missing on the skeleton are added, in one call
+		TArray<FSmartName> MissingNames;
+		for (const FName& CurveName : CurveNames)
+		{
+			FSmartName SmartName;
+			if (!Skeleton->GetSmartNameByName(ContainerName, CurveName, SmartName))
+			{
+				MissingNames.Add(FSmartName(CurveName, SmartName::MaxUID));
+			}
+		}
+
+		if (MissingNames.Num() > 0)
+		{
+			Skeleton->Modify();
+			Skeleton->VerifySmartNames(ContainerName, MissingNames);
+		}
+
+		return MissingNames.Num();
+	}
+
+	void CopyCurveNamesToSkeleton(USkeleton* OldSkeleton, USkeleton* NewSkeleton, const TArray<UAnimationAsset*>& AnimAssets, bool bIncludeTransformCurves)
+	{
+		// on the same skeleton the curve UIDs of the assets are already valid
+		if (!NewSkeleton || OldSkeleton == NewSkeleton)
+		{
+			return;
+		}
+
+		TArray<UAnimSequenceBase*> Sequences;
+		TSet<FName> FloatCurveNames;
+		TSet<FName> TransformCurveNames;
+		for (UAnimationAsset* AnimAsset : AnimAssets)
+		{
+			UAnimSequenceBase* SequenceBase = Cast<UAnimSequenceBase>(AnimAsset);
+			if (!SequenceBase)
+			{
+				continue;
+			}
+			Sequences.Add(SequenceBase);
+
+			const UAnimDataModel* DataModel = SequenceBase->GetDataModel();
+			for (const FFloatCurve& Curve : DataModel->GetFloatCurves())
+			{
+				FloatCurveNames.Add(Curve.Name.DisplayName);
+			}
+
+			if (bIncludeTransformCurves && SequenceBase->IsA<UAnimSequence>())
+			{
+				for (const FTransformCurve& Curve : DataModel->GetTransformCurves())
+				{
+					TransformCurveNames.Add(Curve.Name.DisplayName);
+				}
+			}
+		}
+
+		const int32 NumFloatAdded = AddCurveNamesToSkeleton(NewSkeleton, USkeleton::AnimCurveMappingName, FloatCurveNames);
+		const int32 NumTransformAdded = AddCurveNamesToSkeleton(NewSkeleton, USkeleton::AnimTrackCurveMappingName, TransformCurveNames);
+
+		// the curves still carry UIDs of the old skeleton's mapping, point them at the new one, sequences the caller keeps
+		// bracketed only notify once the caller closes its bracket
+		const bool ShouldTransactAnimEdits = false;
+		for (UAnimSequenceBase* SequenceBase : Sequences)
+		{
+			IAnimationDataController& Controller = SequenceBase->GetController();
+			Controller.OpenBracket(LOCTEXT("UpdateCurveNames", "Updating curve names from the new skeleton"), ShouldTransactAnimEdits);
+			Controller.UpdateCurveNamesFromSkeleton(NewSkeleton, ERawCurveTrackTypes::RCT_Float, ShouldTransactAnimEdits);
+			if (bIncludeTransformCurves && SequenceBase->IsA<UAnimSequence>())
+			{
+				Controller.UpdateCurveNamesFromSkeleton(NewSkeleton, ERawCurveTrackTypes::RCT_Transform, ShouldTransactAnimEdits);
+			}
+			Controller.CloseBracket(ShouldTransactAnimEdits);
+		}
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Curve names from %d assets: %d float (%d added), %d transform (%d added) on %s"),
+			AnimAssets.Num(), FloatCurveNames.Num(), NumFloatAdded, TransformCurveNames.Num(), NumTransformAdded, *NewSkeleton->GetName());
+	}
+
+	int32 TransferSockets(const USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bDryRun)
+	{
+		if (!OldSkeleton || !NewSkeleton || OldSkeleton == NewSkeleton)
+		{
+			return 0;
+		}
+
+		const bool bTransferVirtualBones = CVarTransferVirtualBones.GetValueOnGameThread();
+		const FReferenceSkeleton& NewRefSkeleton = NewSkeleton->GetReferenceSkeleton();
+
+		// names already on the new skeleton, planned transfers are added as we go
+		TSet<FName> SocketNames;
+		SocketNames.Reserve(NewSkeleton->Sockets.Num() + OldSkeleton->Sockets.Num());
+		for (const USkeletalMeshSocket* Socket : NewSkeleton->Sockets)
+		{
+			if (Socket)
+			{
+				SocketNames.Add(Socket->SocketName);
+			}
+		}
+
+		TArray<const USkeletalMeshSocket*> SocketsToCopy;
+		for (const USkeletalMeshSocket* OldSocket : OldSkeleton->Sockets)
+		{
+			if (OldSocket && !SocketNames.Contains(OldSocket->SocketName) && NewRefSkeleton.FindBoneIndex(OldSocket->BoneName) != INDEX_NONE)
+			{
+				SocketNames.Add(OldSocket->SocketName);
+				SocketsToCopy.Add(OldSocket);
+			}
+		}
+
+		TSet<FName> VirtualBoneNames;
+		for (const FVirtualBone& VirtualBone : NewSkeleton->GetVirtualBones())
+		{
+			VirtualBoneNames.Add(VirtualBone.VirtualBoneName);
+		}
+
+		// virtual bones may be built on top of each other, the old skeleton keeps them in dependency order
+		TArray<const FVirtualBone*> VirtualBonesToCopy;
+		auto HasBone = [&NewRefSkeleton, &VirtualBoneNames](const FName& BoneName)
+		{
+			return NewRefSkeleton.FindBoneIndex(BoneName) != INDEX_NONE || VirtualBoneNames.Contains(BoneName);
+		};
+		for (const FVirtualBone& VirtualBone : OldSkeleton->GetVirtualBones())
+		{
+			if (!VirtualBoneNames.Contains(VirtualBone.VirtualBoneName) && HasBone(VirtualBone.SourceBoneName) && HasBone(VirtualBone.TargetBoneName))
+			{
+				VirtualBoneNames.Add(VirtualBone.VirtualBoneName);
+				VirtualBonesToCopy.Add(&VirtualBone);
+			}
+		}
+
+		if (bDryRun)
+		{
+			for (const USkeletalMeshSocket* Socket : SocketsToCopy)
+			{
+				UE_LOG(LogRetargetSkeleton, Log, TEXT("Would copy socket %s on bone %s to %s"), *Socket->SocketName.ToString(), *Socket->BoneName.ToString(), *NewSkeleton->GetName());
+			}
+			for (const FVirtualBone* VirtualBone : VirtualBonesToCopy)
+			{
+				UE_LOG(LogRetargetSkeleton, Log, TEXT("%s virtual bone %s (%s -> %s) to %s"), bTransferVirtualBones ? TEXT("Would copy") : TEXT("Would skip, RetargetSkeleton.TransferVirtualBones is off,"),
+					*VirtualBone->VirtualBoneName.ToString(), *VirtualBone->SourceBoneName.ToString(), *VirtualBone->TargetBoneName.ToString(), *NewSkeleton->GetName());
+			}
+
+			return SocketsToCopy.Num() + (bTransferVirtualBones ? VirtualBonesToCopy.Num() : 0);
+		}
+
+		if (!bTransferVirtualBones)
+		{
+			VirtualBonesToCopy.Reset();
+		}
+
+		if (SocketsToCopy.Num() == 0 && VirtualBonesToCopy.Num() == 0)
+		{
+			return 0;
+		}
+
+		NewSkeleton->Modify();
+
+		for (const USkeletalMeshSocket* OldSocket : SocketsToCopy)
+		{
+			USkeletalMeshSocket* NewSocket = NewObject<USkeletalMeshSocket>(NewSkeleton);
+			NewSocket->CopyFrom(OldSocket);
+			NewSkeleton->Sockets.Add(NewSocket);
+		}
+
+		int32 NumVirtualBonesCopied = 0;
+		for (const FVirtualBone* VirtualBone : VirtualBonesToCopy)
+		{
+			FName AddedName;
+			if (NewSkeleton->AddNewVirtualBone(VirtualBone->SourceBoneName, VirtualBone->TargetBoneName, AddedName))
+			{
+				if (AddedName != VirtualBone->VirtualBoneName)
+				{
+					NewSkeleton->RenameVirtualBone(AddedName, VirtualBone->VirtualBoneName);
+				}
+				++NumVirtualBonesCopied;
+			}
+		}
+
+		NewSkeleton->MarkPackageDirty();
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Copied %d sockets and %d virtual bones from %s to %s"), SocketsToCopy.Num(), NumVirtualBonesCopied, *OldSkeleton->GetName(), *NewSkeleton->GetName());
+
+		return SocketsToCopy.Num() + NumVirtualBonesCopied;
+	}
+
+	/** Appends the blueprint after any of its parents that are part of the batch */
+	static void AddParentsFirst(UAnimBlueprint* AnimBlueprint, const TSet<UAnimBlueprint*>& Batch, TSet<UAnimBlueprint*>& Visited, TArray<UAnimBlueprint*>& OutOrder)
+	{
+		if (Visited.Contains(AnimBlueprint))
+		{
+			return;
+		}
+		Visited.Add(AnimBlueprint);
+
+		UAnimBlueprint* ParentBlueprint = AnimBlueprint->ParentClass ? Cast<UAnimBlueprint>(UBlueprint::GetBlueprintFromClass(AnimBlueprint->ParentClass)) : nullptr;
+		if (ParentBlueprint && Batch.Contains(ParentBlueprint))
+		{
+			AddParentsFirst(ParentBlueprint, Batch, Visited, OutOrder);
+		}
+
+		OutOrder.Add(AnimBlueprint);
+	}
+
+	int32 CompileAnimBlueprints(const TArray<UAnimBlueprint*>& AnimBlueprints)
+	{
+		TSet<UAnimBlueprint*> Batch;
+		for (UAnimBlueprint* AnimBlueprint : AnimBlueprints)
+		{
+			if (AnimBlueprint)
+			{
+				Batch.Add(AnimBlueprint);
+			}
+		}
+
+		if (Batch.Num() == 0)
+		{
+			return 0;
+		}
+
+		// list order is kept wherever the hierarchy allows it
+		TArray<UAnimBlueprint*> CompileOrder;
+		CompileOrder.Reserve(Batch.Num());
+		TSet<UAnimBlueprint*> Visited;
+		for (UAnimBlueprint* AnimBlueprint : AnimBlueprints)
+		{
+			if (AnimBlueprint)
+			{
+				AddParentsFirst(AnimBlueprint, Batch, Visited, CompileOrder);
+			}
+		}
+
+		FScopedSlowTask Progress(CompileOrder.Num(), LOCTEXT("CompilingAnimBlueprints", "Compiling animation blueprints..."));
+
+		const double StartTime = FPlatformTime::Seconds();
+		double SlowestSeconds = 0.0;
+		const UAnimBlueprint* SlowestBlueprint = nullptr;
+
+		for (UAnimBlueprint* AnimBlueprint : CompileOrder)
+		{
+			Progress.EnterProgressFrame(1.f, FText::FromString(AnimBlueprint->GetName()));
+
+			const double BlueprintStartTime = FPlatformTime::Seconds();
+
+			FBlueprintEditorUtils::RefreshAllNodes(AnimBlueprint);
+			FKismetEditorUtilities::CompileBlueprint(AnimBlueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+			const double BlueprintSeconds = FPlatformTime::Seconds() - BlueprintStartTime;
+			if (BlueprintSeconds > SlowestSeconds)
+			{
+				SlowestSeconds = BlueprintSeconds;
+				SlowestBlueprint = AnimBlueprint;
+			}
+
+			UE_LOG(LogRetargetSkeleton, Log, TEXT("Compiled %s in %.2f ms"), *AnimBlueprint->GetPathName(), BlueprintSeconds * 1000.0);
+		}
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Compiled %d anim blueprints in %.2f s, slowest %s (%.2f ms)"),
+			CompileOrder.Num(), FPlatformTime::Seconds() - StartTime, *GetNameSafe(SlowestBlueprint), SlowestSeconds * 1000.0);
+
+		return CompileOrder.Num();
+	}
+
+	void CompressAnimSequences(const TArray<UAnimSequence*>& Sequences)
+	{
+		if (Sequences.Num() == 0)
+		{
+			return;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// close every bracket first so the compression requests overlap, then collect the results
+		const bool ShouldTransactAnimEdits = false;
+		for (UAnimSequence* Sequence : Sequences)
+		{
+			if (Sequence)
+			{
+				Sequence->GetController().CloseBracket(ShouldTransactAnimEdits);
+			}
+		}
+
+		FScopedSlowTask Progress(Sequences.Num(), LOCTEXT("CompressingSequences", "Compressing retargeted animations..."));
+		for (UAnimSequence* Sequence : Sequences)
+		{
+			Progress.EnterProgressFrame(1.f);
+			if (Sequence)
+			{
+				Sequence->WaitOnExistingCompression();
+			}
+		}
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Compressed %d sequences in %.2f s"), Sequences.Num(), FPlatformTime::Seconds() - StartTime);
+	}
+
+	void QueueComponentRefresh(USkeleton* Skeleton)
+	{
+		if (!Skeleton)
+		{
+			return;
+		}
+
+		PendingRefreshSkeletons.Add(Skeleton);
+		if (!PendingRefreshHandle.IsValid())
+		{
+			PendingRefreshHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&RefreshPendingComponents));
+		}
+	}
+
+	void CancelComponentRefresh()
+	{
+		if (PendingRefreshHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(PendingRefreshHandle);
+			PendingRefreshHandle.Reset();
+		}
+		PendingRefreshSkeletons.Reset();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
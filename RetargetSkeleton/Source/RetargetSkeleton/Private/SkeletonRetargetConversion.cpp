@@ -0,0 +1,337 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SkeletonRetargetConversion.h"
+#include "Animation/Skeleton.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/AnimDataModel.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/Rig.h"
+#include "Engine/SkeletalMesh.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "RetargetBatchStages.h"
+
+#define LOCTEXT_NAMESPACE "SkeletonRetargetConversion"
+
+static TAutoConsoleVariable<bool> CVarVerifyRigConversion(
+	TEXT("RetargetSkeleton.VerifyRigConversion"),
+	false,
+	TEXT("Whether the legacy rig retarget also converts a transient copy of its first sequence through UAnimationAsset::ReplaceSkeleton and logs the tracks that differ."));
+
+namespace SkeletonRetargetConversion
+{
+	/** Local retarget base pose of the skeleton, the pose FAnimationRuntime::FillUpComponentSpaceTransformsRetargetBasePose builds on */
+	static void GetRetargetBaseLocalPose(const USkeleton* Skeleton, TArray<FTransform>& OutLocalPose)
+	{
+		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+		const USkeletalMesh* PreviewMesh = Skeleton->GetPreviewMesh();
+		if (PreviewMesh && PreviewMesh->GetRetargetBasePose().Num() == RefSkeleton.GetNum())
+		{
+			OutLocalPose = PreviewMesh->GetRetargetBasePose();
+		}
+		else
+		{
+			OutLocalPose = RefSkeleton.GetRefBonePose();
+		}
+	}
+
+	/** Hierarchy and retarget base pose of one skeleton, copied so workers never touch the USkeleton */
+	struct FSkeletonPoseData
+	{
+		TArray<int32> ParentIndices;
+		TArray<FTransform> BaseLocalPose;
+		TArray<FTransform> BaseComponentPose;
+		TArray<FName> BoneNames;
+
+		void Init(const USkeleton* Skeleton)
+		{
+			const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+			const int32 NumBones = RefSkeleton.GetNum();
+
+			GetRetargetBaseLocalPose(Skeleton, BaseLocalPose);
+
+			// parents always come before their children
+			ParentIndices.SetNum(NumBones);
+			BoneNames.SetNum(NumBones);
+			BaseComponentPose.SetNum(NumBones);
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+			{
+				ParentIndices[BoneIndex] = RefSkeleton.GetParentIndex(BoneIndex);
+				BoneNames[BoneIndex] = RefSkeleton.GetBoneName(BoneIndex);
+				BaseComponentPose[BoneIndex] = (ParentIndices[BoneIndex] != INDEX_NONE) ? BaseLocalPose[BoneIndex] * BaseComponentPose[ParentIndices[BoneIndex]] : BaseLocalPose[BoneIndex];
+			}
+		}
+	};
+
+	/** One sequence worth of conversion work */
+	struct FSequenceConversionJob
+	{
+		UAnimSequence* Sequence = nullptr;
+		int32 NumKeys = 0;
+
+		/** Source tracks copied from the data model, and the track of each old bone or INDEX_NONE */
+		TArray<FRawAnimSequenceTrack> SourceTracks;
+		TArray<int32> OldBoneToTrack;
+
+		/** Converted tracks, staged until they are applied on the game thread */
+		TArray<FName> ConvertedBoneNames;
+		TArray<FRawAnimSequenceTrack> ConvertedTracks;
+	};
+
+	static bool CanConvertThroughRig(const USkeleton* OldSkeleton, const USkeleton* NewSkeleton)
+	{
+		return OldSkeleton && NewSkeleton && OldSkeleton->GetRig() && OldSkeleton->GetRig() == NewSkeleton->GetRig();
+	}
+
+	static FTransform GetTrackKey(const FRawAnimSequenceTrack& Track, int32 KeyIndex)
+	{
+		// tracks with a single key hold it for the whole sequence
+		const FVector3f Position = Track.PosKeys.Num() > 0 ? Track.PosKeys[FMath::Min(KeyIndex, Track.PosKeys.Num() - 1)] : FVector3f::ZeroVector;
+		const FQuat4f Rotation = Track.RotKeys.Num() > 0 ? Track.RotKeys[FMath::Min(KeyIndex, Track.RotKeys.Num() - 1)] : FQuat4f::Identity;
+		const FVector3f Scale = Track.ScaleKeys.Num() > 0 ? Track.ScaleKeys[FMath::Min(KeyIndex, Track.ScaleKeys.Num() - 1)] : FVector3f::OneVector;
+
+		return FTransform(FQuat(Rotation), FVector(Position), FVector(Scale));
+	}
+
+	/** Converts one sequence, runs on worker threads and only reads the job and the shared pose data */
+	static void ConvertSequence(FSequenceConversionJob& Job, const FRigBoneTranslationTable& Table, const FSkeletonPoseData& OldPose, const FSkeletonPoseData& NewPose)
+	{
+		const int32 NumOldBones = OldPose.ParentIndices.Num();
+		const int32 NumNewBones = NewPose.ParentIndices.Num();
+
+		// only bones following an old bone get a track, the rest stay on the reference pose
+		TArray<int32> NewBoneToTrack;
+		NewBoneToTrack.Init(INDEX_NONE, NumNewBones);
+		for (int32 NewBoneIndex = 0; NewBoneIndex < NumNewBones; ++NewBoneIndex)
+		{
+			if (Table.NewToOldBone[NewBoneIndex] != INDEX_NONE)
+			{
+				NewBoneToTrack[NewBoneIndex] = Job.ConvertedBoneNames.Add(NewPose.BoneNames[NewBoneIndex]);
+				FRawAnimSequenceTrack& Track = Job.ConvertedTracks.AddDefaulted_GetRef();
+				Track.PosKeys.SetNum(Job.NumKeys);
+				Track.RotKeys.SetNum(Job.NumKeys);
+				Track.ScaleKeys.SetNum(Job.NumKeys);
+			}
+		}
+
+		TArray<FTransform> OldComponentPose;
+		OldComponentPose.SetNum(NumOldBones);
+		TArray<FTransform> NewComponentPose;
+		NewComponentPose.SetNum(NumNewBones);
+
+		for (int32 KeyIndex = 0; KeyIndex < Job.NumKeys; ++KeyIndex)
+		{
+			// parents always come before their children
+			for (int32 OldBoneIndex = 0; OldBoneIndex < NumOldBones; ++OldBoneIndex)
+			{
+				const int32 TrackIndex = Job.OldBoneToTrack[OldBoneIndex];
+				const FTransform LocalPose = (TrackIndex != INDEX_NONE) ? GetTrackKey(Job.SourceTracks[TrackIndex], KeyIndex) : OldPose.BaseLocalPose[OldBoneIndex];
+				const int32 ParentIndex = OldPose.ParentIndices[OldBoneIndex];
+				OldComponentPose[OldBoneIndex] = (ParentIndex != INDEX_NONE) ? LocalPose * OldComponentPose[ParentIndex] : LocalPose;
+			}
+
+			for (int32 NewBoneIndex = 0; NewBoneIndex < NumNewBones; ++NewBoneIndex)
+			{
+				const int32 ParentIndex = NewPose.ParentIndices[NewBoneIndex];
+				const FTransform ParentComponentPose = (ParentIndex != INDEX_NONE) ? NewComponentPose[ParentIndex] : FTransform::Identity;
+
+				const int32 OldBoneIndex = Table.NewToOldBone[NewBoneIndex];
+				if (OldBoneIndex == INDEX_NONE)
+				{
+					NewComponentPose[NewBoneIndex] = NewPose.BaseLocalPose[NewBoneIndex] * ParentComponentPose;
+					continue;
+				}
+
+				// animated translation is kept, scaled by how long the bone is on the new skeleton compared to the old one
+				const FTransform ConvertedComponentPose = Table.NewRelativeToOld[NewBoneIndex] * OldComponentPose[OldBoneIndex];
+				FTransform LocalPose = ConvertedComponentPose.GetRelativeTransform(ParentComponentPose);
+				if (ParentIndex != INDEX_NONE)
+				{
+					const float OldLength = OldPose.BaseLocalPose[OldBoneIndex].GetTranslation().Size();
+					if (OldLength > KINDA_SMALL_NUMBER)
+					{
+						const float NewLength = NewPose.BaseLocalPose[NewBoneIndex].GetTranslation().Size();
+						LocalPose.ScaleTranslation(NewLength / OldLength);
+					}
+				}
+				LocalPose.NormalizeRotation();
+				NewComponentPose[NewBoneIndex] = LocalPose * ParentComponentPose;
+
+				FRawAnimSequenceTrack& Track = Job.ConvertedTracks[NewBoneToTrack[NewBoneIndex]];
+				Track.PosKeys[KeyIndex] = FVector3f(LocalPose.GetTranslation());
+				Track.RotKeys[KeyIndex] = FQuat4f(LocalPose.GetRotation());
+				Track.ScaleKeys[KeyIndex] = FVector3f(LocalPose.GetScale3D());
+			}
+		}
+	}
+
+	FRigBoneTranslationTable FRigBoneTranslationTable::Build(const USkeleton* OldSkeleton, const USkeleton* NewSkeleton)
+	{
+		const FReferenceSkeleton& OldRefSkeleton = OldSkeleton->GetReferenceSkeleton();
+		const FReferenceSkeleton& NewRefSkeleton = NewSkeleton->GetReferenceSkeleton();
+
+		// the same retarget base pose the conversion falls back to for bones without a track
+		FSkeletonPoseData OldPose;
+		FSkeletonPoseData NewPose;
+		OldPose.Init(OldSkeleton);
+		NewPose.Init(NewSkeleton);
+		const TArray<FTransform>& OldBasePose = OldPose.BaseComponentPose;
+		const TArray<FTransform>& NewBasePose = NewPose.BaseComponentPose;
+
+		FRigBoneTranslationTable Table;
+		Table.NewToOldBone.Init(INDEX_NONE, NewRefSkeleton.GetNum());
+		Table.NewRelativeToOld.Init(FTransform::Identity, NewRefSkeleton.GetNum());
+
+		const URig* Rig = OldSkeleton->GetRig();
+		for (const FNode& Node : Rig->GetNodes())
+		{
+			const int32 OldBoneIndex = OldRefSkeleton.FindBoneIndex(OldSkeleton->GetRigBoneMapping(Node.Name));
+			const int32 NewBoneIndex = NewRefSkeleton.FindBoneIndex(NewSkeleton->GetRigBoneMapping(Node.Name));
+			if (OldBasePose.IsValidIndex(OldBoneIndex) && NewBasePose.IsValidIndex(NewBoneIndex))
+			{
+				Table.NewToOldBone[NewBoneIndex] = OldBoneIndex;
+				Table.NewRelativeToOld[NewBoneIndex] = NewBasePose[NewBoneIndex].GetRelativeTransform(OldBasePose[OldBoneIndex]);
+			}
+		}
+
+		return Table;
+	}
+
+	/** Logs the tracks of a converted job that differ from the engine conversion of the same sequence */
+	static void VerifyAgainstEngineConversion(const FSequenceConversionJob& Job, UAnimSequence* EngineSequence, USkeleton* NewSkeleton)
+	{
+		EngineSequence->ReplaceSkeleton(NewSkeleton, true);
+
+		TMap<FName, const FRawAnimSequenceTrack*> EngineTracks;
+		for (const FBoneAnimationTrack& BoneTrack : EngineSequence->GetDataModel()->GetBoneAnimationTracks())
+		{
+			EngineTracks.Add(BoneTrack.Name, &BoneTrack.InternalTrackData);
+		}
+
+		int32 NumMismatches = 0;
+		for (int32 TrackIndex = 0; TrackIndex < Job.ConvertedTracks.Num(); ++TrackIndex)
+		{
+			const FName& BoneName = Job.ConvertedBoneNames[TrackIndex];
+			const FRawAnimSequenceTrack* const* EngineTrack = EngineTracks.Find(BoneName);
+			if (!EngineTrack)
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Rig conversion check %s: engine conversion has no track for %s"), *Job.Sequence->GetName(), *BoneName.ToString());
+				++NumMismatches;
+				continue;
+			}
+
+			float MaxTranslationError = 0.f;
+			float MaxRotationError = 0.f;
+			for (int32 KeyIndex = 0; KeyIndex < Job.NumKeys; ++KeyIndex)
+			{
+				const FTransform Converted = GetTrackKey(Job.ConvertedTracks[TrackIndex], KeyIndex);
+				const FTransform Engine = GetTrackKey(**EngineTrack, KeyIndex);
+				MaxTranslationError = FMath::Max(MaxTranslationError, (float)FVector::Dist(Converted.GetTranslation(), Engine.GetTranslation()));
+				MaxRotationError = FMath::Max(MaxRotationError, (float)Converted.GetRotation().AngularDistance(Engine.GetRotation()));
+			}
+
+			if (MaxTranslationError > 0.1f || MaxRotationError > 0.01f)
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Rig conversion check %s: %s differs from the engine conversion by up to %.3f cm and %.4f rad"),
+					*Job.Sequence->GetName(), *BoneName.ToString(), MaxTranslationError, MaxRotationError);
+				++NumMismatches;
+			}
+		}
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Rig conversion check %s: %d of %d tracks differ from the engine conversion"), *Job.Sequence->GetName(), NumMismatches, Job.ConvertedTracks.Num());
+	}
+
+	void ReplaceSkeleton(const TArray<UAnimationAsset*>& AnimAssets, USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bConvertSpaces)
+	{
+		const bool bConvertThroughRig = bConvertSpaces && CanConvertThroughRig(OldSkeleton, NewSkeleton);
+
+		FSkeletonPoseData OldPose;
+		FSkeletonPoseData NewPose;
+		FRigBoneTranslationTable Table;
+		if (bConvertThroughRig)
+		{
+			OldPose.Init(OldSkeleton);
+			NewPose.Init(NewSkeleton);
+			Table = FRigBoneTranslationTable::Build(OldSkeleton, NewSkeleton);
+		}
+
+		// gather on the game thread, everything the workers need is copied into the jobs
+		TArray<FSequenceConversionJob> Jobs;
+		UAnimSequence* EngineSequence = nullptr;
+		for (UAnimationAsset* AnimAsset : AnimAssets)
+		{
+			UAnimSequence* Sequence = Cast<UAnimSequence>(AnimAsset);
+			if (!bConvertThroughRig || !Sequence || Sequence->GetSkeleton() != OldSkeleton)
+			{
+				AnimAsset->ReplaceSkeleton(NewSkeleton, bConvertSpaces);
+				continue;
+			}
+
+			FSequenceConversionJob& Job = Jobs.AddDefaulted_GetRef();
+			Job.Sequence = Sequence;
+
+			// the engine converts an untouched transient copy of the first sequence for comparison
+			if (!EngineSequence && CVarVerifyRigConversion.GetValueOnGameThread())
+			{
+				EngineSequence = DuplicateObject<UAnimSequence>(Sequence, GetTransientPackage());
+			}
+
+			const UAnimDataModel* DataModel = Sequence->GetDataModel();
+			Job.NumKeys = DataModel->GetNumberOfKeys();
+			Job.OldBoneToTrack.Init(INDEX_NONE, OldPose.ParentIndices.Num());
+			for (const FBoneAnimationTrack& BoneTrack : DataModel->GetBoneAnimationTracks())
+			{
+				const int32 OldBoneIndex = OldSkeleton->GetReferenceSkeleton().FindBoneIndex(BoneTrack.Name);
+				if (OldBoneIndex != INDEX_NONE)
+				{
+					Job.OldBoneToTrack[OldBoneIndex] = Job.SourceTracks.Add(BoneTrack.InternalTrackData);
+				}
+			}
+		}
+
+		const double ConvertStartTime = FPlatformTime::Seconds();
+
+		ParallelFor(Jobs.Num(), [&Jobs, &Table, &OldPose, &NewPose](int32 JobIndex)
+		{
+			ConvertSequence(Jobs[JobIndex], Table, OldPose, NewPose);
+		});
+
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Converted %d sequences through rig in %.2f s"), Jobs.Num(), FPlatformTime::Seconds() - ConvertStartTime);
+
+		if (EngineSequence && Jobs.Num() > 0)
+		{
+			VerifyAgainstEngineConversion(Jobs[0], EngineSequence, NewSkeleton);
+			EngineSequence->MarkAsGarbage();
+		}
+
+		// all UObject changes happen back on the game thread, the skeleton swaps in the same bracket as the tracks so
+		// nothing is notified or compressed before the converted data is in
+		TArray<UAnimSequence*> SequencesToCompress;
+		for (FSequenceConversionJob& Job : Jobs)
+		{
+			IAnimationDataController& Controller = Job.Sequence->GetController();
+			const bool bShouldTransact = false;
+			Controller.OpenBracket(LOCTEXT("ConvertTracks", "Converting tracks to new skeleton"), bShouldTransact);
+			Job.Sequence->SetSkeleton(NewSkeleton);
+			if (Job.NumKeys > 0)
+			{
+				Controller.RemoveAllBoneTracks(bShouldTransact);
+				for (int32 TrackIndex = 0; TrackIndex < Job.ConvertedTracks.Num(); ++TrackIndex)
+				{
+					const FName& BoneName = Job.ConvertedBoneNames[TrackIndex];
+					const FRawAnimSequenceTrack& Track = Job.ConvertedTracks[TrackIndex];
+					Controller.AddBoneTrack(BoneName, bShouldTransact);
+					Controller.SetBoneTrackKeys(BoneName, Track.PosKeys, Track.RotKeys, Track.ScaleKeys, bShouldTransact);
+				}
+			}
+			Job.Sequence->MarkPackageDirty();
+			SequencesToCompress.Add(Job.Sequence);
+		}
+
+		// closes the brackets, each sequence notifies and compresses once
+		RetargetBatchStages::CompressAnimSequences(SequencesToCompress);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
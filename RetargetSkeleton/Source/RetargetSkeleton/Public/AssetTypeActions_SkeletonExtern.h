@@ -1,47 +1,57 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Animation/Skeleton.h"
-#include "Toolkits/IToolkitHost.h"
-#include "AssetTypeActions_Base.h"
-#include "EditorAnimUtils.h"
-#include "Developer/AssetTools/Private/AssetTypeActions/AssetTypeActions_Skeleton.h"
-
-
-//class FAssetTypeActions_SkeletonOverride : public FAssetTypeActions_Base
-class FAssetTypeActions_SkeletonExtern
-{
-
-////////////////////////////// ue4 Rig&BoneMapping //////////////////////////
-public:
-	bool OnAssetCreated(TArray<UObject*> NewAssets) const;
-
-	/** Handler for when Create Rig is selected */
-	void ExecuteCreateRig(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
-	void CreateRig(const TWeakObjectPtr<USkeleton> Skeleton);
-
-
-	/** Handler for when Skeleton Retarget is selected */
-	void ExecuteRetargetSkeleton(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
-	void PerformRetarget(USkeleton* OldSkeleton, USkeleton* NewSkeleton, TArray<FName> Packages, bool bConvertSpaces) const;
-
-	// utility functions for performing retargeting,these codes are from AssetRenameManager workflow
-	void LoadPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, TArray<UPackage*>& OutPackagesToSave) const;
-	bool CheckOutPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, TArray<UPackage*>& InOutPackagesToSave) const;
-	void ReportFailures(const TArray<FAssetToRemapSkeleton>& AssetsToRemap) const;
-	void RetargetSkeleton(TArray<FAssetToRemapSkeleton>& AssetsToRemap, USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bConvertSpaces) const;
-	void SavePackages(const TArray<UPackage*> PackagesToSave) const;
-	void DetectReadOnlyPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, TArray<UPackage*>& InOutPackagesToSave) const;
-	/** Handler for retargeting */
-	void RetargetAnimationHandler(USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bRemapReferencedAssets, bool bAllowRemapToExisting, bool bConvertSpaces, const EditorAnimUtils::FNameDuplicationRule* NameRule);
-
-	void CreateUniqueAssetName(const FString& InBasePackageName, const FString& InSuffix, FString& OutPackageName, FString& OutAssetName) const;
-
-
-///////////////////////////////  ue5 ikretargeter  ////////////////////////////
-public:
-	void ExecuteRetargetSkeleton_IKRetargeter(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
-
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/Skeleton.h"
+#include "Toolkits/IToolkitHost.h"
+#include "AssetTypeActions_Base.h"
+#include "EditorAnimUtils.h"
+#include "Developer/AssetTools/Private/AssetTypeActions/AssetTypeActions_Skeleton.h"
+
+
+//class FAssetTypeActions_SkeletonOverride : public FAssetTypeActions_Base
+class FAssetTypeActions_SkeletonExtern
+{
+
+////////////////////////////// ue4 Rig&BoneMapping //////////////////////////
+public:
+	/** Package -> indices into the remap list of the assets it holds */
+	typedef TMap<const UPackage*, TArray<int32>> FPackageToRemapIndex;
+
+	bool OnAssetCreated(TArray<UObject*> NewAssets) const;
+
+	/** Handler for when Create Rig is selected */
+	void ExecuteCreateRig(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
+	void CreateRig(const TWeakObjectPtr<USkeleton> Skeleton);
+
+
+	/** Handler for when Skeleton Retarget is selected */
+	void ExecuteRetargetSkeleton(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
+	void PerformRetarget(USkeleton* OldSkeleton, USkeleton* NewSkeleton, TArray<FName> Packages, bool bConvertSpaces) const;
+	/**
+	 * Loads, checks out, retargets and saves one chunk of referencers, returns false if the user declined the checkout.
+	 * With MinChunkSize above 0 the chunk is trimmed to what was loaded when the resident memory limit ends it early.
+	 */
+	bool PerformRetargetChunk(TArray<FAssetToRemapSkeleton>& AssetsToRemap, USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bConvertSpaces, bool bPromptForCheckout, bool bReleaseAfterSave, int32 MinChunkSize = 0) const;
+
+	// utility functions for performing retargeting,these codes are from AssetRenameManager workflow
+	void LoadPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, TArray<UPackage*>& OutPackagesToSave, int32 MinLoadsBeforeResidentLimit = 0) const;
+	bool CheckOutPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, const FPackageToRemapIndex& PackageToRemap, TArray<UPackage*>& InOutPackagesToSave, bool bPromptUser = true) const;
+	void ReportFailures(const TArray<FAssetToRemapSkeleton>& AssetsToRemap) const;
+	void RetargetSkeleton(TArray<FAssetToRemapSkeleton>& AssetsToRemap, USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bConvertSpaces) const;
+	void SavePackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, const FPackageToRemapIndex& PackageToRemap, const TArray<UPackage*> PackagesToSave) const;
+	void DetectReadOnlyPackages(TArray<FAssetToRemapSkeleton>& AssetsToRemap, const FPackageToRemapIndex& PackageToRemap, TArray<UPackage*>& InOutPackagesToSave) const;
+	void BuildPackageToRemapIndex(const TArray<FAssetToRemapSkeleton>& AssetsToRemap, FPackageToRemapIndex& OutPackageToRemap) const;
+	void ReportPackageFailed(TArray<FAssetToRemapSkeleton>& AssetsToRemap, const FPackageToRemapIndex& PackageToRemap, const UPackage* Package, const FText& Reason) const;
+	/** Handler for retargeting */
+	void RetargetAnimationHandler(USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bRemapReferencedAssets, bool bAllowRemapToExisting, bool bConvertSpaces, const EditorAnimUtils::FNameDuplicationRule* NameRule);
+
+	void CreateUniqueAssetName(const FString& InBasePackageName, const FString& InSuffix, FString& OutPackageName, FString& OutAssetName) const;
+
+
+///////////////////////////////  ue5 ikretargeter  ////////////////////////////
+public:
+	void ExecuteRetargetSkeleton_IKRetargeter(TArray<TWeakObjectPtr<USkeleton>> Skeletons);
+
+};
@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IKRetargetBatchJournal.h"
+#include "IKRigEditor/Public/RetargetEditor/IKRetargetBatchOperation.h"
+#include "Retargeter/IKRetargeter.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "RetargetBatchStages.h"
+
+namespace IKRetargetBatchJournal
+{
+	static const int32 Version = 1;
+
+	static const TCHAR* PhaseToString(EIKRetargetJournalPhase Phase)
+	{
+		switch (Phase)
+		{
+		case EIKRetargetJournalPhase::Retargeted:
+			return TEXT("Retargeted");
+		case EIKRetargetJournalPhase::Saved:
+			return TEXT("Saved");
+		default:
+			return TEXT("None");
+		}
+	}
+
+	static EIKRetargetJournalPhase PhaseFromString(const FString& Phase)
+	{
+		if (Phase == TEXT("Retargeted"))
+		{
+			return EIKRetargetJournalPhase::Retargeted;
+		}
+		if (Phase == TEXT("Saved"))
+		{
+			return EIKRetargetJournalPhase::Saved;
+		}
+		return EIKRetargetJournalPhase::None;
+	}
+
+	static FString DescribeBatch(const FIKRetargetBatchOperationContext& Context, const FString& BatchTag)
+	{
+		const USkeleton* SourceSkeleton = Context.SourceMesh ? Context.SourceMesh->GetSkeleton() : nullptr;
+		return FString::Printf(TEXT("%s|%s|%s|%s"), *GetPathNameSafe(SourceSkeleton), *GetPathNameSafe(Context.TargetMesh), *GetPathNameSafe(Context.IKRetargetAsset), *BatchTag);
+	}
+}
+
+FString FIKRetargetBatchJournal::GetJournalFilename(const FIKRetargetBatchOperationContext& Context, const FString& BatchTag)
+{
+	const USkeleton* SourceSkeleton = Context.SourceMesh ? Context.SourceMesh->GetSkeleton() : nullptr;
+	const uint32 BatchHash = FCrc::StrCrc32(*IKRetargetBatchJournal::DescribeBatch(Context, BatchTag));
+	return FPaths::ProjectSavedDir() / TEXT("RetargetSkeleton") / FString::Printf(TEXT("IKRetarget_%s_%08x.json"), *GetNameSafe(SourceSkeleton), BatchHash);
+}
+
+bool FIKRetargetBatchJournal::Open(const FIKRetargetBatchOperationContext& Context, const FString& BatchTag)
+{
+	Filename = GetJournalFilename(Context, BatchTag);
+	BatchDescription = IKRetargetBatchJournal::DescribeBatch(Context, BatchTag);
+	AssetPhases.Reset();
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *Filename))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Ignoring unreadable retarget journal %s"), *Filename);
+		return false;
+	}
+
+	// a journal from another batch with a colliding name, or from an older format, can't be trusted
+	if (JsonObject->GetIntegerField(TEXT("Version")) != IKRetargetBatchJournal::Version || JsonObject->GetStringField(TEXT("Batch")) != BatchDescription)
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Ignoring retarget journal %s written for another batch"), *Filename);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* AssetsObject = nullptr;
+	if (JsonObject->TryGetObjectField(TEXT("Assets"), AssetsObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*AssetsObject)->Values)
+		{
+			const EIKRetargetJournalPhase Phase = IKRetargetBatchJournal::PhaseFromString(Pair.Value->AsString());
+			if (Phase != EIKRetargetJournalPhase::None)
+			{
+				AssetPhases.Add(FName(*Pair.Key), Phase);
+			}
+		}
+	}
+
+	return true;
+}
+
+void FIKRetargetBatchJournal::GetAssetsInPhase(EIKRetargetJournalPhase Phase, TSet<FName>& OutObjectPaths) const
+{
+	for (const TPair<FName, EIKRetargetJournalPhase>& Pair : AssetPhases)
+	{
+		if (Pair.Value == Phase)
+		{
+			OutObjectPaths.Add(Pair.Key);
+		}
+	}
+}
+
+void FIKRetargetBatchJournal::SetPhase(const TArray<FName>& ObjectPaths, EIKRetargetJournalPhase Phase)
+{
+	if (!IsOpen() || ObjectPaths.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FName& ObjectPath : ObjectPaths)
+	{
+		AssetPhases.Add(ObjectPath, Phase);
+	}
+
+	if (!Write())
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to write retarget journal %s, an interrupted batch won't be able to resume"), *Filename);
+	}
+}
+
+void FIKRetargetBatchJournal::Complete()
+{
+	if (IsOpen())
+	{
+		IFileManager::Get().Delete(*Filename, false, true, true);
+	}
+
+	Filename.Reset();
+	AssetPhases.Reset();
+}
+
+bool FIKRetargetBatchJournal::Write() const
+{
+	TSharedRef<FJsonObject> AssetsObject = MakeShared<FJsonObject>();
+	for (const TPair<FName, EIKRetargetJournalPhase>& Pair : AssetPhases)
+	{
+		AssetsObject->SetStringField(Pair.Key.ToString(), IKRetargetBatchJournal::PhaseToString(Pair.Value));
+	}
+
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("Version"), IKRetargetBatchJournal::Version);
+	JsonObject->SetStringField(TEXT("Batch"), BatchDescription);
+	JsonObject->SetObjectField(TEXT("Assets"), AssetsObject);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	if (!FJsonSerializer::Serialize(JsonObject, Writer))
+	{
+		return false;
+	}
+
+	// write next to the journal and swap, so a crash mid-write never leaves a truncated journal
+	const FString TempFilename = Filename + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(JsonText, *TempFilename))
+	{
+		return false;
+	}
+
+	return IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+}
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FIKRetargetBatchOperationContext;
+
+/** Furthest phase an asset reached in a journaled IK retarget batch */
+enum class EIKRetargetJournalPhase : uint8
+{
+	None,
+	/** Retargeted in memory, not saved yet, redone on resume. The journal is kept while any asset is left here */
+	Retargeted,
+	/** Saved to disk, skipped on resume */
+	Saved,
+};
+
+/**
+ * Progress journal of a paged IK retarget batch, written under Saved/RetargetSkeleton.
+ * The journal is rewritten after every page and deleted once every asset it tracks is saved, so a journal found
+ * when the same batch starts again means the previous run was interrupted or left assets unsaved.
+ */
+class FIKRetargetBatchJournal
+{
+public:
+	/** Journal file used for the given batch, one per source skeleton, target mesh, retargeter and tag */
+	static FString GetJournalFilename(const FIKRetargetBatchOperationContext& Context, const FString& BatchTag = FString());
+
+	/**
+	 * Starts journaling the batch, loading the journal of an interrupted run if there is one
+	 *
+	 * @param	BatchTag	Tells apart batches sharing the same context, such as the shards of a multi-process batch
+	 * @return	true if a previous run of the same batch is being resumed
+	 */
+	bool Open(const FIKRetargetBatchOperationContext& Context, const FString& BatchTag = FString());
+
+	bool IsOpen() const { return !Filename.IsEmpty(); }
+
+	/** Gathers the object paths of every asset that reached the given phase */
+	void GetAssetsInPhase(EIKRetargetJournalPhase Phase, TSet<FName>& OutObjectPaths) const;
+
+	/** Records the phase of the given assets and writes the journal to disk */
+	void SetPhase(const TArray<FName>& ObjectPaths, EIKRetargetJournalPhase Phase);
+
+	/** Deletes the journal, the batch finished */
+	void Complete();
+
+private:
+	bool Write() const;
+
+	FString Filename;
+	FString BatchDescription;
+	TMap<FName, EIKRetargetJournalPhase> AssetPhases;
+};
@@ -23,10 +23,21 @@
 #include "Animation/AnimMontage.h"
 
 #include "SSkeletonRetarget_IK.h"
+#include "RetargetBatchStages.h"
+#include "IKRetargetBatchPlanner.h"
 #include "EditorAssetLibrary.h"
+#include "FileHelpers.h"
+#include "ISourceControlModule.h"
+#include "PackageTools.h"
+#include "HAL/IConsoleManager.h"
 
 #define LOCTEXT_NAMESPACE "RetargetBatchOperation"
 
+static TAutoConsoleVariable<int32> CVarRetargetPageSize(
+	TEXT("RetargetSkeleton.PageSize"),
+	200,
+	TEXT("Number of referencing assets loaded at once by the IK skeleton retarget. Each page is saved and unloaded before the next one is loaded."));
+
 namespace NS_IKRetargetTool
 {
 	static FString GetAssetsPathInPlatform(const FString& BaseDir, UPackage* Package)
@@ -54,12 +65,39 @@ int32 FIKRetargetBatchOperation_Copy::GenerateAssetLists(const FIKRetargetBatchO
 	AnimationAssetsToRetarget.Reset();
 	AnimBlueprintsToRetarget.Reset();
 
+	// hashed membership for the closure, the arrays keep discovery order
+	TSet<UAnimationAsset*> KnownAnimAssets;
+	TSet<UAnimBlueprint*> KnownBlueprints;
+	int32 DiscoveredCounts[(int32)EAssetDiscovery::Num] = {};
+
+	auto AddAnimAsset = [this, &KnownAnimAssets, &DiscoveredCounts](UAnimationAsset* AnimAsset, EAssetDiscovery Discovery)
+	{
+		bool bAlreadyKnown = false;
+		KnownAnimAssets.Add(AnimAsset, &bAlreadyKnown);
+		if (!bAlreadyKnown)
+		{
+			AnimationAssetsToRetarget.Add(AnimAsset);
+			++DiscoveredCounts[(int32)Discovery];
+		}
+	};
+
+	auto AddBlueprint = [this, &KnownBlueprints, &DiscoveredCounts](UAnimBlueprint* AnimBlueprint, EAssetDiscovery Discovery)
+	{
+		bool bAlreadyKnown = false;
+		KnownBlueprints.Add(AnimBlueprint, &bAlreadyKnown);
+		if (!bAlreadyKnown)
+		{
+			AnimBlueprintsToRetarget.Add(AnimBlueprint);
+			++DiscoveredCounts[(int32)Discovery];
+		}
+	};
+
 	for (TWeakObjectPtr<UObject> AssetPtr : Context.AssetsToRetarget)
 	{
 		UObject* Asset = AssetPtr.Get();
 		if (UAnimationAsset* AnimAsset = Cast<UAnimationAsset>(Asset))
 		{
-			AnimationAssetsToRetarget.AddUnique(AnimAsset);
+			AddAnimAsset(AnimAsset, EAssetDiscovery::Selected);
 
 			// sequences that are used within the montage need to be added as well to be duplicated. They will then
 			// be replaced in UAnimMontage::ReplaceReferredAnimations
@@ -72,7 +110,7 @@ int32 FIKRetargetBatchOperation_Copy::GenerateAssetLists(const FIKRetargetBatchO
 					{
 						if (Segment.IsValid() && Segment.AnimReference)
 						{
-							AnimationAssetsToRetarget.AddUnique(Segment.AnimReference);
+							AddAnimAsset(Segment.AnimReference, EAssetDiscovery::MontageSegment);
 						}
 					}
 				}
@@ -80,7 +118,7 @@ int32 FIKRetargetBatchOperation_Copy::GenerateAssetLists(const FIKRetargetBatchO
 				// add preview pose
 				if (AnimMontage->PreviewBasePose)
 				{
-					AnimationAssetsToRetarget.AddUnique(AnimMontage->PreviewBasePose);
+					AddAnimAsset(AnimMontage->PreviewBasePose, EAssetDiscovery::PreviewPose);
 				}
 			}
 		}
@@ -90,31 +128,67 @@ int32 FIKRetargetBatchOperation_Copy::GenerateAssetLists(const FIKRetargetBatchO
 			UAnimBlueprint* ParentBP = Cast<UAnimBlueprint>(AnimBlueprint->ParentClass->ClassGeneratedBy);
 			while (ParentBP)
 			{
-				AnimBlueprintsToRetarget.AddUnique(ParentBP);
+				AddBlueprint(ParentBP, EAssetDiscovery::ParentBlueprint);
 				ParentBP = Cast<UAnimBlueprint>(ParentBP->ParentClass->ClassGeneratedBy);
 			}
 
-			AnimBlueprintsToRetarget.AddUnique(AnimBlueprint);
+			AddBlueprint(AnimBlueprint, EAssetDiscovery::Selected);
 		}
 	}
 
 	if (Context.bRemapReferencedAssets)
 	{
+		// the engine helpers AddUnique into whatever they are given, so each one fills a small scratch list
+		TArray<UAnimationAsset*> ReferencedAssets;
+
 		// Grab assets from the blueprint.
 		// Do this first as it can add complex assets to the retarget array which will need to be processed next.
 		for (UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
 		{
-			GetAllAnimationSequencesReferredInBlueprint(AnimBlueprint, AnimationAssetsToRetarget);
+			ReferencedAssets.Reset();
+			GetAllAnimationSequencesReferredInBlueprint(AnimBlueprint, ReferencedAssets);
+			for (UAnimationAsset* ReferencedAsset : ReferencedAssets)
+			{
+				AddAnimAsset(ReferencedAsset, EAssetDiscovery::BlueprintReference);
+			}
 		}
 
+		// work queue over the growing list, direct references only since the queue itself provides the recursion
 		int32 AssetIndex = 0;
 		while (AssetIndex < AnimationAssetsToRetarget.Num())
 		{
 			UAnimationAsset* AnimAsset = AnimationAssetsToRetarget[AssetIndex++];
-			AnimAsset->HandleAnimReferenceCollection(AnimationAssetsToRetarget, true);
+
+			ReferencedAssets.Reset();
+			AnimAsset->HandleAnimReferenceCollection(ReferencedAssets, false);
+			for (UAnimationAsset* ReferencedAsset : ReferencedAssets)
+			{
+				AddAnimAsset(ReferencedAsset, EAssetDiscovery::AnimReference);
+			}
 		}
 	}
 
+	UE_LOG(LogRetargetSkeleton, Log, TEXT("Asset lists: %d selected, %d montage segments, %d preview poses, %d parent blueprints, %d blueprint references, %d animation references"),
+		DiscoveredCounts[(int32)EAssetDiscovery::Selected],
+		DiscoveredCounts[(int32)EAssetDiscovery::MontageSegment],
+		DiscoveredCounts[(int32)EAssetDiscovery::PreviewPose],
+		DiscoveredCounts[(int32)EAssetDiscovery::ParentBlueprint],
+		DiscoveredCounts[(int32)EAssetDiscovery::BlueprintReference],
+		DiscoveredCounts[(int32)EAssetDiscovery::AnimReference]);
+
+	// assets shared between pages were already retargeted by an earlier one
+	AnimationAssetsToRetarget.RemoveAll([this](const UAnimationAsset* AnimAsset) { return ProcessedAssets.Contains(FName(*AnimAsset->GetPathName())); });
+	AnimBlueprintsToRetarget.RemoveAll([this](const UAnimBlueprint* AnimBlueprint) { return ProcessedAssets.Contains(FName(*AnimBlueprint->GetPathName())); });
+
+	for (const UAnimationAsset* AnimAsset : AnimationAssetsToRetarget)
+	{
+		ProcessedAssets.Add(FName(*AnimAsset->GetPathName()));
+	}
+	for (const UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
+	{
+		ProcessedAssets.Add(FName(*AnimBlueprint->GetPathName()));
+	}
+
 	return AnimationAssetsToRetarget.Num();
 }
 
@@ -124,6 +198,12 @@ void FIKRetargetBatchOperation_Copy::DuplicateRetargetAssets(
 {
 	Progress.EnterProgressFrame(1.f, FText(LOCTEXT("BatchRetarget", "Skeleton Retarget animation assets...")));
 
+	if (bInPlace)
+	{
+		SnapshotRetargetAssets();
+		return;
+	}
+
 	UPackage* DestinationPackage = Context.TargetMesh->GetOutermost();
 
 	TArray<UAnimationAsset*> AnimationAssetsToDuplicate = AnimationAssetsToRetarget;
@@ -186,22 +266,74 @@ void FIKRetargetBatchOperation_Copy::DuplicateRetargetAssets(
 	DuplicatedBlueprints.GenerateValueArray(AnimBlueprintsToRetarget);
 }
 
-void FIKRetargetBatchOperation_Copy::RetargetAssets(
-	const FIKRetargetBatchOperationContext& Context,
-	FScopedSlowTask& Progress)
+void FIKRetargetBatchOperation_Copy::SnapshotRetargetAssets()
 {
-	USkeleton* OldSkeleton = Context.SourceMesh->GetSkeleton();
-	USkeleton* NewSkeleton = Context.TargetMesh->GetSkeleton();
+	// only sequences are evaluated, everything else is retargeted without needing its source data
+	UPackage* TransientPackage = GetTransientPackage();
+	for (UAnimationAsset* AnimAsset : AnimationAssetsToRetarget)
+	{
+		UAnimSequence* Sequence = Cast<UAnimSequence>(AnimAsset);
+		if (!Sequence)
+		{
+			continue;
+		}
+
+		const FName SnapshotName = MakeUniqueObjectName(TransientPackage, UAnimSequence::StaticClass(), Sequence->GetFName());
+		UAnimSequence* Snapshot = DuplicateObject<UAnimSequence>(Sequence, TransientPackage, SnapshotName);
+		Snapshot->ClearFlags(RF_Public | RF_Standalone);
+		Snapshot->SetFlags(RF_Transient);
+
+		DuplicatedAnimAssets.Add(Snapshot, Sequence);
+	}
+}
+
+void FIKRetargetBatchOperation_Copy::ReleaseSnapshots()
+{
+	for (const TPair<UAnimationAsset*, UAnimationAsset*>& Pair : DuplicatedAnimAssets)
+	{
+		if (Pair.Key)
+		{
+			Pair.Key->MarkAsGarbage();
+		}
+	}
+	DuplicatedAnimAssets.Reset();
+}
+
+void FIKRetargetBatchOperation_Copy::DuplicateForAdditionalTargets()
+{
+	AdditionalTargetCopies.Reset();
+	AdditionalTargetCopies.SetNum(AdditionalTargets.Num());
+
+	// the lists hold the original assets in both modes, still untouched at this point
+	for (int32 TargetIndex = 0; TargetIndex < AdditionalTargets.Num(); ++TargetIndex)
+	{
+		// a target without a processor would only get stripped copies
+		if (!AdditionalProcessors[TargetIndex])
+		{
+			continue;
+		}
+
+		const FIKRetargetAdditionalTarget& Target = AdditionalTargets[TargetIndex];
+		UPackage* DestinationPackage = Target.TargetMesh->GetOutermost();
+		AdditionalTargetCopies[TargetIndex].AnimAssets = DuplicateAssets<UAnimationAsset>(AnimationAssetsToRetarget, DestinationPackage, &Target.NameRule);
+		AdditionalTargetCopies[TargetIndex].Blueprints = DuplicateAssets<UAnimBlueprint>(AnimBlueprintsToRetarget, DestinationPackage, &Target.NameRule);
+	}
+}
 
-	for (UAnimationAsset* AssetToRetarget : AnimationAssetsToRetarget)
+void FIKRetargetBatchOperation_Copy::PrepareAnimAssets(
+	const TArray<UAnimationAsset*>& AnimAssets,
+	USkeletalMesh* TargetMesh,
+	const TMap<UAnimationAsset*, UAnimationAsset*>* ReferenceRemap)
+{
+	USkeleton* NewSkeleton = TargetMesh->GetSkeleton();
+	for (UAnimationAsset* AssetToRetarget : AnimAssets)
 	{
 		// synchronize curves between old/new asset
 		UAnimSequence* AnimSequenceToRetarget = Cast<UAnimSequence>(AssetToRetarget);
 		if (AnimSequenceToRetarget)
 		{
-			// copy curve data from source asset, preserving data in the target if present.
-			UAnimationBlueprintLibrary::CopyAnimationCurveNamesToSkeleton(OldSkeleton, NewSkeleton, AnimSequenceToRetarget, ERawCurveTrackTypes::RCT_Float);
 			// clear transform curves since those curves won't work in new skeleton
+			// the bracket stays open until the whole page is written, so the data model only notifies once
 			IAnimationDataController& Controller = AnimSequenceToRetarget->GetController();
 			const bool ShouldTransactAnimEdits = false;
 			Controller.OpenBracket(FText::FromString("Generating Retargeted Animation Data"), ShouldTransactAnimEdits);
@@ -210,38 +342,104 @@ void FIKRetargetBatchOperation_Copy::RetargetAssets(
 			Controller.RemoveAllBoneTracks(false);
 			// set the retarget source to the target skeletal mesh
 			AnimSequenceToRetarget->RetargetSource = NAME_None;
-			AnimSequenceToRetarget->RetargetSourceAsset = Context.TargetMesh;
-			// done editing sequence data, close bracket
-			Controller.CloseBracket(ShouldTransactAnimEdits);
+			AnimSequenceToRetarget->RetargetSourceAsset = TargetMesh;
 		}
 
 		// replace references to other animation
 		//AssetToRetarget->ReplaceReferredAnimations(RemappedAnimAssets); //Hanmginglu:我们是对旧资源重定向，他们的引用就不用变更了。
+		// copies for additional targets are new assets, they must point at each other rather than at the originals
+		if (ReferenceRemap)
+		{
+			AssetToRetarget->ReplaceReferredAnimations(*ReferenceRemap);
+		}
 		AssetToRetarget->SetSkeleton(NewSkeleton);
-		AssetToRetarget->SetPreviewMesh(Context.TargetMesh);
+		AssetToRetarget->SetPreviewMesh(TargetMesh);
 	}
+}
 
+void FIKRetargetBatchOperation_Copy::FinishAnimAssets(const TArray<UAnimationAsset*>& AnimAssets, TArray<UAnimSequence*>& OutSequencesToCompress)
+{
 	// Call PostEditChange after the references of all assets were replaced, to prevent order dependence of post edit
 	// change hooks. If PostEditChange is called right after ReplaceReferredAnimations it can access references that are
 	// still queued for retarget and follow the current asset in the array.
-	static const FName RetargetSourceAssetPropertyName = GET_MEMBER_NAME_STRING_CHECKED(UAnimSequence, RetargetSourceAsset);
-	static FProperty* RetargetAssetProperty = UAnimSequence::StaticClass()->FindPropertyByName(RetargetSourceAssetPropertyName);
-	for (UAnimationAsset* AssetToRetarget : AnimationAssetsToRetarget)
+	for (UAnimationAsset* AssetToRetarget : AnimAssets)
 	{
-		// force updating of the retarget pose, this is normally done on PreSave() but is guarded against procedural saves
+		// sequences keep the bracket opened by PrepareAnimAssets, any notification now would request a compression
 		if (UAnimSequence* AnimSequenceToRetarget = Cast<UAnimSequence>(AssetToRetarget))
 		{
-			FPropertyChangedEvent RetargetAssetPropertyChangedEvent(RetargetAssetProperty);
-			AnimSequenceToRetarget->PostEditChangeProperty(RetargetAssetPropertyChangedEvent);
+			// force updating of the retarget pose, this is normally done on PreSave() but is guarded against procedural saves
+			AnimSequenceToRetarget->UpdateRetargetSourceAsset();
+			OutSequencesToCompress.Add(AnimSequenceToRetarget);
+		}
+		else
+		{
+			AssetToRetarget->PostEditChange();
 		}
 
-		AssetToRetarget->PostEditChange();
 		AssetToRetarget->MarkPackageDirty();
 	}
+}
+
+void FIKRetargetBatchOperation_Copy::RetargetAssets(
+	const FIKRetargetBatchOperationContext& Context,
+	FScopedSlowTask& Progress)
+{
+	USkeleton* OldSkeleton = Context.SourceMesh->GetSkeleton();
+	USkeleton* NewSkeleton = Context.TargetMesh->GetSkeleton();
+
+	// the planner costs every asset once per target, assets saved by a resumed run never get here
+	RetargetedAssetTargets += AnimationAssetsToRetarget.Num() + AnimBlueprintsToRetarget.Num();
+	for (const FAdditionalTargetCopies& Copies : AdditionalTargetCopies)
+	{
+		RetargetedAssetTargets += Copies.AnimAssets.Num() + Copies.Blueprints.Num();
+	}
+
+	PrepareAnimAssets(AnimationAssetsToRetarget, Context.TargetMesh, nullptr);
+
+	// float curves are left alone by the preparation, their names go to the new skeleton in one update per batch and
+	// the curve UIDs are updated inside the open brackets
+	RetargetBatchStages::CopyCurveNamesToSkeleton(OldSkeleton, NewSkeleton, AnimationAssetsToRetarget, false);
+
+	TArray<UAnimationAsset*> AdditionalAnimAssets;
+	for (int32 TargetIndex = 0; TargetIndex < AdditionalTargetCopies.Num(); ++TargetIndex)
+	{
+		const TMap<UAnimationAsset*, UAnimationAsset*>& Copies = AdditionalTargetCopies[TargetIndex].AnimAssets;
+
+		TArray<UAnimationAsset*> TargetAnimAssets;
+		Copies.GenerateValueArray(TargetAnimAssets);
+		PrepareAnimAssets(TargetAnimAssets, AdditionalTargets[TargetIndex].TargetMesh, &Copies);
+		if (AdditionalProcessors[TargetIndex])
+		{
+			RetargetBatchStages::CopyCurveNamesToSkeleton(OldSkeleton, AdditionalTargets[TargetIndex].TargetMesh->GetSkeleton(), TargetAnimAssets, false);
+		}
+		AdditionalAnimAssets.Append(TargetAnimAssets);
+	}
 
 	// convert the animation using the IK retargeter
 	ConvertAnimation(Context, Progress);
 
+	if (bInPlace)
+	{
+		ReleaseSnapshots();
+	}
+
+	TArray<UAnimSequence*> SequencesToCompress;
+	FinishAnimAssets(AnimationAssetsToRetarget, SequencesToCompress);
+	FinishAnimAssets(AdditionalAnimAssets, SequencesToCompress);
+
+	// every sequence of the page is written, each one notifies and compresses once, all on worker threads
+	RetargetBatchStages::CompressAnimSequences(SequencesToCompress);
+
+	// bring over sockets the new skeleton is missing, the anim blueprints below may attach to them
+	RetargetBatchStages::TransferSockets(OldSkeleton, NewSkeleton);
+	for (int32 TargetIndex = 0; TargetIndex < AdditionalTargets.Num(); ++TargetIndex)
+	{
+		if (AdditionalProcessors[TargetIndex])
+		{
+			RetargetBatchStages::TransferSockets(OldSkeleton, AdditionalTargets[TargetIndex].TargetMesh->GetSkeleton());
+		}
+	}
+
 	// convert all Animation Blueprints and compile 
 	for (UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
 	{
@@ -267,9 +465,38 @@ void FIKRetargetBatchOperation_Copy::RetargetAssets(
 			ReplaceReferredAnimationsInBlueprint(AnimBlueprint, RemappedAnimAssets);
 		}
 		*/
+	}
+
+	// copies for additional targets are new blueprints, re-link them to the copied parents and animations
+	TArray<UAnimBlueprint*> BlueprintsToCompile = AnimBlueprintsToRetarget;
+	for (int32 TargetIndex = 0; TargetIndex < AdditionalTargetCopies.Num(); ++TargetIndex)
+	{
+		const FAdditionalTargetCopies& Copies = AdditionalTargetCopies[TargetIndex];
+		for (const TPair<UAnimBlueprint*, UAnimBlueprint*>& Pair : Copies.Blueprints)
+		{
+			UAnimBlueprint* AnimBlueprint = Pair.Value;
+			AnimBlueprint->TargetSkeleton = AdditionalTargets[TargetIndex].TargetMesh->GetSkeleton();
+
+			UAnimBlueprint* CurrentParentBP = Cast<UAnimBlueprint>(AnimBlueprint->ParentClass->ClassGeneratedBy);
+			if (UAnimBlueprint* const* ParentBP = CurrentParentBP ? Copies.Blueprints.Find(CurrentParentBP) : nullptr)
+			{
+				AnimBlueprint->ParentClass = (*ParentBP)->GeneratedClass;
+			}
+
+			if (Copies.AnimAssets.Num() > 0)
+			{
+				ReplaceReferredAnimationsInBlueprint(AnimBlueprint, Copies.AnimAssets);
+			}
 
-		FBlueprintEditorUtils::RefreshAllNodes(AnimBlueprint);
-		FKismetEditorUtilities::CompileBlueprint(AnimBlueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+			BlueprintsToCompile.Add(AnimBlueprint);
+		}
+	}
+
+	// parents compile before their children, each blueprint once
+	RetargetBatchStages::CompileAnimBlueprints(BlueprintsToCompile);
+
+	for (UAnimBlueprint* AnimBlueprint : BlueprintsToCompile)
+	{
 		AnimBlueprint->PostEditChange();
 		AnimBlueprint->MarkPackageDirty();
 	}
@@ -279,33 +506,51 @@ void FIKRetargetBatchOperation_Copy::ConvertAnimation(
 	const FIKRetargetBatchOperationContext& Context,
 	FScopedSlowTask& Progress)
 {
-	// initialize the retargeter
-	UObject* TransientOuter = Cast<UObject>(GetTransientPackage());
-	UIKRetargetProcessor* Processor = NewObject<UIKRetargetProcessor>(TransientOuter);
-	Processor->Initialize(Context.SourceMesh, Context.TargetMesh, Context.IKRetargetAsset);
-	if (!Processor->IsInitialized())
+	// one processor per target, all fed from the same evaluated source pose
+	struct FConversionTarget
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Unable to initialize the IK Retargeter. Newly created animations were not retargeted!"));
-		return;
-	}
-
-	// target skeleton data
-	const FTargetSkeleton& TargetSkeleton = Processor->GetTargetSkeleton();
-	const TArray<FName>& TargetBoneNames = TargetSkeleton.BoneNames;
-	const int32 NumTargetBones = TargetBoneNames.Num();
+		UIKRetargetProcessor* Processor = nullptr;
+		/** Original asset to copy, null for the context target which retargets the originals */
+		const TMap<UAnimationAsset*, UAnimationAsset*>* Copies = nullptr;
+		TArray<FRawAnimSequenceTrack> BoneTracks;
+	};
 
-	// allocate target keyframe data
-	TArray<FRawAnimSequenceTrack> BoneTracks;
-	BoneTracks.SetNumZeroed(NumTargetBones);
+	// initialized by InitializeProcessors before the assets were touched
+	UIKRetargetProcessor* Processor = RetargetProcessor;
 
 	// source skeleton data
 	const FRetargetSkeleton& SourceSkeleton = Processor->GetSourceSkeleton();
 	const TArray<FName>& SourceBoneNames = SourceSkeleton.BoneNames;
 	const int32 NumSourceBones = SourceBoneNames.Num();
 
+	TArray<FConversionTarget> ConversionTargets;
+	ConversionTargets.AddDefaulted_GetRef().Processor = Processor;
+	for (int32 TargetIndex = 0; TargetIndex < AdditionalTargets.Num(); ++TargetIndex)
+	{
+		if (!AdditionalProcessors[TargetIndex])
+		{
+			continue;
+		}
+
+		FConversionTarget& ConversionTarget = ConversionTargets.AddDefaulted_GetRef();
+		ConversionTarget.Processor = AdditionalProcessors[TargetIndex];
+		ConversionTarget.Copies = &AdditionalTargetCopies[TargetIndex].AnimAssets;
+	}
+
+	// allocate target keyframe data
+	for (FConversionTarget& ConversionTarget : ConversionTargets)
+	{
+		ConversionTarget.BoneTracks.SetNumZeroed(ConversionTarget.Processor->GetTargetSkeleton().BoneNames.Num());
+	}
+
 	TArray<FTransform> SourceComponentPose;
 	SourceComponentPose.SetNum(NumSourceBones);
 
+	TArray<UAnimSequence*> DestinationSequences;
+	DestinationSequences.SetNum(ConversionTargets.Num());
+
+	const double ConvertStartTime = FPlatformTime::Seconds();
+
 	// for each pair of source / target animation sequences
 	for (TPair<UAnimationAsset*, UAnimationAsset*>& Pair : DuplicatedAnimAssets)
 	{
@@ -320,21 +565,32 @@ void FIKRetargetBatchOperation_Copy::ConvertAnimation(
 		FString AssetName = DestinationSequence->GetName();
 		Progress.EnterProgressFrame(1.f, FText::Format(LOCTEXT("RunningBatchRetarget", "Retargeting animation asset: {Asset}"), FText::FromString(AssetName)));
 
-		// remove all keys from the destination animation sequence
-		IAnimationDataController& TargetSeqController = DestinationSequence->GetController();
-		const bool ShouldTransactAnimEdits = false;
-		TargetSeqController.OpenBracket(FText::FromString("Generating Retargeted Animation Data"), ShouldTransactAnimEdits);
-		TargetSeqController.RemoveAllBoneTracks();
-
 		// number of frames in this animation
 		const int32 NumFrames = SourceSequence->GetNumberOfSampledKeys();
 
-		// BoneTracks arrays allocation
-		for (int32 TargetBoneIndex = 0; TargetBoneIndex < NumTargetBones; ++TargetBoneIndex)
+		// the same source sequence is written to the original and to its copy for every additional target
+		const bool ShouldTransactAnimEdits = false;
+		for (int32 TargetIndex = 0; TargetIndex < ConversionTargets.Num(); ++TargetIndex)
 		{
-			BoneTracks[TargetBoneIndex].PosKeys.SetNum(NumFrames);
-			BoneTracks[TargetBoneIndex].RotKeys.SetNum(NumFrames);
-			BoneTracks[TargetBoneIndex].ScaleKeys.SetNum(NumFrames);
+			FConversionTarget& ConversionTarget = ConversionTargets[TargetIndex];
+			DestinationSequences[TargetIndex] = ConversionTarget.Copies ? Cast<UAnimSequence>(ConversionTarget.Copies->FindRef(DestinationSequence)) : DestinationSequence;
+			if (!DestinationSequences[TargetIndex])
+			{
+				continue;
+			}
+
+			// remove all keys from the destination animation sequence
+			IAnimationDataController& TargetSeqController = DestinationSequences[TargetIndex]->GetController();
+			TargetSeqController.OpenBracket(FText::FromString("Generating Retargeted Animation Data"), ShouldTransactAnimEdits);
+			TargetSeqController.RemoveAllBoneTracks();
+
+			// BoneTracks arrays allocation
+			for (FRawAnimSequenceTrack& BoneTrack : ConversionTarget.BoneTracks)
+			{
+				BoneTrack.PosKeys.SetNum(NumFrames);
+				BoneTrack.RotKeys.SetNum(NumFrames);
+				BoneTrack.ScaleKeys.SetNum(NumFrames);
+			}
 		}
 
 		// ensure we evaluate the source animation using the skeletal mesh proportions that were evaluated in the viewport
@@ -344,7 +600,7 @@ void FIKRetargetBatchOperation_Copy::ConvertAnimation(
 		// retarget each frame's pose from source to target
 		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
 		{
-			// get the source global pose
+			// get the source global pose, once for all targets
 			FAnimPose SourcePoseAtFrame;
 			UAnimPoseExtensions::GetAnimPoseAtFrame(SourceSequence, FrameIndex, EvaluationOptions, SourcePoseAtFrame);
 
@@ -356,43 +612,69 @@ void FIKRetargetBatchOperation_Copy::ConvertAnimation(
 				SourceComponentPose[BoneIndex] = UAnimPoseExtensions::GetBonePose(SourcePoseAtFrame, BoneName, EAnimPoseSpaces::World);
 			}
 
-			// update goals 
-			Processor->CopyAllSettingsFromAsset();
+			for (int32 TargetIndex = 0; TargetIndex < ConversionTargets.Num(); ++TargetIndex)
+			{
+				if (!DestinationSequences[TargetIndex])
+				{
+					continue;
+				}
 
-			// run the retarget
-			const TArray<FTransform>& TargetComponentPose = Processor->RunRetargeter(SourceComponentPose);
+				FConversionTarget& ConversionTarget = ConversionTargets[TargetIndex];
+				const FTargetSkeleton& TargetSkeleton = ConversionTarget.Processor->GetTargetSkeleton();
 
-			// convert to a local-space pose
-			TArray<FTransform> TargetLocalPose = TargetComponentPose;
-			TargetSkeleton.UpdateLocalTransformsBelowBone(0, TargetLocalPose, TargetComponentPose);
+				// update goals 
+				ConversionTarget.Processor->CopyAllSettingsFromAsset();
 
-			// store key data for each bone
-			for (int32 TargetBoneIndex = 0; TargetBoneIndex < NumTargetBones; ++TargetBoneIndex)
-			{
-				const FTransform& LocalPose = TargetLocalPose[TargetBoneIndex];
+				// run the retarget
+				const TArray<FTransform>& TargetComponentPose = ConversionTarget.Processor->RunRetargeter(SourceComponentPose);
+
+				// convert to a local-space pose
+				TArray<FTransform> TargetLocalPose = TargetComponentPose;
+				TargetSkeleton.UpdateLocalTransformsBelowBone(0, TargetLocalPose, TargetComponentPose);
 
-				FRawAnimSequenceTrack& BoneTrack = BoneTracks[TargetBoneIndex];
+				// store key data for each bone
+				for (int32 TargetBoneIndex = 0; TargetBoneIndex < ConversionTarget.BoneTracks.Num(); ++TargetBoneIndex)
+				{
+					const FTransform& LocalPose = TargetLocalPose[TargetBoneIndex];
+
+					FRawAnimSequenceTrack& BoneTrack = ConversionTarget.BoneTracks[TargetBoneIndex];
 
-				BoneTrack.PosKeys[FrameIndex] = FVector3f(LocalPose.GetLocation());
-				BoneTrack.RotKeys[FrameIndex] = FQuat4f(LocalPose.GetRotation());
-				BoneTrack.ScaleKeys[FrameIndex] = FVector3f(LocalPose.GetScale3D());
+					BoneTrack.PosKeys[FrameIndex] = FVector3f(LocalPose.GetLocation());
+					BoneTrack.RotKeys[FrameIndex] = FQuat4f(LocalPose.GetRotation());
+					BoneTrack.ScaleKeys[FrameIndex] = FVector3f(LocalPose.GetScale3D());
+				}
 			}
 		}
 
 		// add keys to bone tracks
 		const bool bShouldTransact = false;
-		for (int32 TargetBoneIndex = 0; TargetBoneIndex < NumTargetBones; ++TargetBoneIndex)
+		for (int32 TargetIndex = 0; TargetIndex < ConversionTargets.Num(); ++TargetIndex)
 		{
-			const FName& TargetBoneName = TargetBoneNames[TargetBoneIndex];
+			if (!DestinationSequences[TargetIndex])
+			{
+				continue;
+			}
 
-			const FRawAnimSequenceTrack& RawTrack = BoneTracks[TargetBoneIndex];
-			TargetSeqController.AddBoneTrack(TargetBoneName, bShouldTransact);
-			TargetSeqController.SetBoneTrackKeys(TargetBoneName, RawTrack.PosKeys, RawTrack.RotKeys, RawTrack.ScaleKeys);
-		}
+			const FConversionTarget& ConversionTarget = ConversionTargets[TargetIndex];
+			const TArray<FName>& TargetBoneNames = ConversionTarget.Processor->GetTargetSkeleton().BoneNames;
+			IAnimationDataController& TargetSeqController = DestinationSequences[TargetIndex]->GetController();
+			for (int32 TargetBoneIndex = 0; TargetBoneIndex < TargetBoneNames.Num(); ++TargetBoneIndex)
+			{
+				const FName& TargetBoneName = TargetBoneNames[TargetBoneIndex];
 
-		// done editing sequence data, close bracket
-		TargetSeqController.CloseBracket(ShouldTransactAnimEdits);
+				const FRawAnimSequenceTrack& RawTrack = ConversionTarget.BoneTracks[TargetBoneIndex];
+				TargetSeqController.AddBoneTrack(TargetBoneName, bShouldTransact);
+				TargetSeqController.SetBoneTrackKeys(TargetBoneName, RawTrack.PosKeys, RawTrack.RotKeys, RawTrack.ScaleKeys);
+			}
+
+			// done editing sequence data, close bracket
+			TargetSeqController.CloseBracket(ShouldTransactAnimEdits);
+
+			ConvertedFrameBones += int64(NumFrames) * TargetBoneNames.Num();
+		}
 	}
+
+	ConvertSeconds += FPlatformTime::Seconds() - ConvertStartTime;
 }
 
 void FIKRetargetBatchOperation_Copy::NotifyUserOfResults(
@@ -400,10 +682,19 @@ void FIKRetargetBatchOperation_Copy::NotifyUserOfResults(
 	FScopedSlowTask& Progress) const
 {
 	//删除临时文件夹	
-	UEditorAssetLibrary::DeleteDirectory(Context.NameRule.FolderPath);
+	if (!bInPlace)
+	{
+		UEditorAssetLibrary::DeleteDirectory(Context.NameRule.FolderPath);
+	}
 
 	Progress.EnterProgressFrame(1.f, FText(LOCTEXT("DoneRetarget", "Skeleton Retarget complete!")));
 
+	// worker processes report through their result file
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
 	// notify user
 	FNotificationInfo Notification(FText::GetEmpty());
 	Notification.ExpireDuration = 5.f;
@@ -448,8 +739,95 @@ void FIKRetargetBatchOperation_Copy:: GetOldAssets(TArray<UObject*>& OldAssets)
 }
 
 
+bool FIKRetargetBatchOperation_Copy::InitializeProcessors(const FIKRetargetBatchOperationContext& Context)
+{
+	ReleaseProcessors();
+
+	RetargetProcessor = NewObject<UIKRetargetProcessor>(GetTransientPackage());
+	RetargetProcessor->AddToRoot();
+	RetargetProcessor->Initialize(Context.SourceMesh, Context.TargetMesh, Context.IKRetargetAsset);
+	if (RetargetProcessor->IsInitialized())
+	{
+		const TArray<FName>& SourceBoneNames = RetargetProcessor->GetSourceSkeleton().BoneNames;
+
+		AdditionalProcessors.SetNumZeroed(AdditionalTargets.Num());
+		for (int32 TargetIndex = 0; TargetIndex < AdditionalTargets.Num(); ++TargetIndex)
+		{
+			const FIKRetargetAdditionalTarget& Target = AdditionalTargets[TargetIndex];
+			if (!Target.TargetMesh || Target.TargetMesh == Context.TargetMesh)
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Additional target %s is the batch target, skipped."), *GetNameSafe(Target.TargetMesh));
+				continue;
+			}
+
+			UIKRetargetProcessor* TargetProcessor = NewObject<UIKRetargetProcessor>(GetTransientPackage());
+			TargetProcessor->AddToRoot();
+			AdditionalProcessors[TargetIndex] = TargetProcessor;
+			TargetProcessor->Initialize(Context.SourceMesh, Target.TargetMesh, Target.IKRetargetAsset);
+
+			// the shared source pose is laid out for the context processor's source skeleton
+			if (!TargetProcessor->IsInitialized() || TargetProcessor->GetSourceSkeleton().BoneNames != SourceBoneNames)
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Unable to initialize the IK Retargeter %s for %s from the batch source. No copies are made for it."),
+					*GetNameSafe(Target.IKRetargetAsset), *GetNameSafe(Target.TargetMesh));
+				TargetProcessor->RemoveFromRoot();
+				AdditionalProcessors[TargetIndex] = nullptr;
+			}
+		}
+		return true;
+	}
+
+	UE_LOG(LogRetargetSkeleton, Error, TEXT("Unable to initialize the IK Retargeter %s for %s. Nothing was retargeted."),
+		*GetNameSafe(Context.IKRetargetAsset), *GetNameSafe(Context.TargetMesh));
+
+	if (!IsRunningCommandlet())
+	{
+		FNotificationInfo Notification(LOCTEXT("RetargeterInitFailed", "Unable to initialize the IK Retargeter, nothing was retargeted. See Output for details."));
+		Notification.ExpireDuration = 5.f;
+		FSlateNotificationManager::Get().AddNotification(Notification);
+	}
+
+	ReleaseProcessors();
+	return false;
+}
+
+void FIKRetargetBatchOperation_Copy::ReleaseProcessors()
+{
+	if (RetargetProcessor)
+	{
+		RetargetProcessor->RemoveFromRoot();
+		RetargetProcessor = nullptr;
+	}
+
+	for (UIKRetargetProcessor* TargetProcessor : AdditionalProcessors)
+	{
+		if (TargetProcessor)
+		{
+			TargetProcessor->RemoveFromRoot();
+		}
+	}
+	AdditionalProcessors.Reset();
+}
+
+int32 FIKRetargetBatchOperation_Copy::GetPageSize()
+{
+	const RetargetBatchStages::FMemoryBudget Budget = RetargetBatchStages::FMemoryBudget::FromConsoleVariables();
+	return FMath::Max(Budget.GetFlushInterval(CVarRetargetPageSize.GetValueOnGameThread()), 1);
+}
+
 void FIKRetargetBatchOperation_Copy::RunRetarget(FIKRetargetBatchOperationContext& Context)
 {
+	ProcessedAssets.Reset();
+	RetargetedAssetTargets = 0;
+	ConvertedFrameBones = 0;
+	ConvertSeconds = 0.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (!InitializeProcessors(Context))
+	{
+		return;
+	}
+
 	const int32 NumAssets = GenerateAssetLists(Context);
 
 	// show progress bar
@@ -457,8 +835,316 @@ void FIKRetargetBatchOperation_Copy::RunRetarget(FIKRetargetBatchOperationContex
 	Progress.MakeDialog();
 
 	DuplicateRetargetAssets(Context, Progress);
+	DuplicateForAdditionalTargets();
 	RetargetAssets(Context, Progress);
 	NotifyUserOfResults(Context, Progress);
+	ReleaseProcessors();
+
+	// blueprint compiles skip garbage collection, the batch collects once now that nothing of it is referenced
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FIKRetargetBatchPlanner::RecordBatch(RetargetedAssetTargets, ConvertedFrameBones, ConvertSeconds, FPlatformTime::Seconds() - StartTime);
+
+	RetargetBatchStages::QueueComponentRefresh(Context.SourceMesh->GetSkeleton());
+}
+
+void FIKRetargetBatchOperation_Copy::RunRetarget(FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& AssetsToLoad)
+{
+	ProcessedAssets.Reset();
+	RetargetedAssetTargets = 0;
+	ConvertedFrameBones = 0;
+	ConvertSeconds = 0.0;
+	bCheckOutPrompted = false;
+	bCheckOutAccepted = false;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// before the first page is loaded, a retargeter that can't run must not strip anything
+	if (!InitializeProcessors(Context))
+	{
+		return;
+	}
+
+	// a memory budget overrides the page size and can end a page early, it only helps if pages are saved and unloaded
+	const RetargetBatchStages::FMemoryBudget Budget = RetargetBatchStages::FMemoryBudget::FromConsoleVariables();
+	const int32 PageSize = GetPageSize();
+	const int32 MinPageSize = FMath::Min(Budget.MinAssetsBeforeFlush, PageSize);
+	const bool bPaged = bSavePages || Budget.IsEnabled();
+
+	FScopedSlowTask Progress(AssetsToLoad.Num() + 1, LOCTEXT("GatheringBatchRetarget", "Gathering animation assets..."));
+	Progress.MakeDialog();
+
+	// only paged batches save as they go, so only they can resume
+	if (bPaged && Journal.Open(Context, BatchTag))
+	{
+		// assets saved by the interrupted run are neither loaded nor retargeted again
+		Journal.GetAssetsInPhase(EIKRetargetJournalPhase::Saved, ProcessedAssets);
+
+		// retargeted in memory but never saved, their packages on disk are still untouched
+		TSet<FName> UnsavedAssets;
+		Journal.GetAssetsInPhase(EIKRetargetJournalPhase::Retargeted, UnsavedAssets);
+		UE_LOG(LogRetargetSkeleton, Log, TEXT("Resuming interrupted retarget batch, %d assets already saved, %d retargeted without being saved are redone"),
+			ProcessedAssets.Num(), UnsavedAssets.Num());
+
+		// the interrupted run may have left its duplicates behind
+		if (!Context.NameRule.FolderPath.IsEmpty() && UEditorAssetLibrary::DoesDirectoryExist(Context.NameRule.FolderPath))
+		{
+			UEditorAssetLibrary::DeleteDirectory(Context.NameRule.FolderPath);
+		}
+	}
+
+	int32 NextAssetIndex = 0;
+	while (NextAssetIndex < AssetsToLoad.Num())
+	{
+		const int32 PageStart = NextAssetIndex;
+
+		// load only this page, anything pulled in by an earlier page is skipped
+		Context.AssetsToRetarget.Reset();
+		while (NextAssetIndex < AssetsToLoad.Num() && NextAssetIndex - PageStart < PageSize)
+		{
+			const FAssetData& AssetData = AssetsToLoad[NextAssetIndex++];
+			if (ProcessedAssets.Contains(AssetData.ObjectPath))
+			{
+				continue;
+			}
+
+			if (UObject* Asset = AssetData.GetAsset())
+			{
+				Context.AssetsToRetarget.Add(Asset);
+			}
+
+			if (Context.AssetsToRetarget.Num() >= MinPageSize && Budget.IsOverResidentLimit())
+			{
+				UE_LOG(LogRetargetSkeleton, Log, TEXT("Resident memory over budget, ending retarget page after %d assets"), NextAssetIndex - PageStart);
+				break;
+			}
+		}
+
+		Progress.EnterProgressFrame(NextAssetIndex - PageStart, FText::Format(LOCTEXT("LoadingBatchRetargetPage", "Retargeting assets {0} to {1} of {2}..."),
+			FText::AsNumber(PageStart + 1), FText::AsNumber(NextAssetIndex), FText::AsNumber(AssetsToLoad.Num())));
+
+		RetargetPage(Context);
+
+		// without saving, pages only bound how much is loaded at once and the results are left for the user to save
+		if (bPaged)
+		{
+			TArray<FName> RetargetedObjectPaths;
+			GetRetargetObjectPaths(RetargetedObjectPaths);
+			Journal.SetPhase(RetargetedObjectPaths, EIKRetargetJournalPhase::Retargeted);
+
+			// like the legacy chunks, a declined check-out ends the batch
+			if (!ReleasePage(Context))
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Check-out declined, retarget batch stopped after %d of %d assets. The last page is left unsaved."),
+					NextAssetIndex, AssetsToLoad.Num());
+				break;
+			}
+		}
+	}
+
+	// the journal is the only record of unfinished work, it only goes once everything it tracks reached the disk
+	if (Journal.IsOpen())
+	{
+		TSet<FName> UnsavedAssets;
+		Journal.GetAssetsInPhase(EIKRetargetJournalPhase::Retargeted, UnsavedAssets);
+		if (NextAssetIndex == AssetsToLoad.Num() && UnsavedAssets.Num() == 0)
+		{
+			Journal.Complete();
+		}
+		else
+		{
+			UE_LOG(LogRetargetSkeleton, Warning, TEXT("Retarget batch left %d assets unsaved, run it again to resume from %s"),
+				UnsavedAssets.Num(), *FIKRetargetBatchJournal::GetJournalFilename(Context, BatchTag));
+		}
+	}
+
+	NotifyUserOfResults(Context, Progress);
+	ReleaseProcessors();
+
+	// blueprint compiles skip garbage collection, the batch collects once now that nothing of it is referenced
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FIKRetargetBatchPlanner::RecordBatch(RetargetedAssetTargets, ConvertedFrameBones, ConvertSeconds, FPlatformTime::Seconds() - StartTime);
+
+	RetargetBatchStages::QueueComponentRefresh(Context.SourceMesh->GetSkeleton());
+}
+
+void FIKRetargetBatchOperation_Copy::RetargetPage(const FIKRetargetBatchOperationContext& Context)
+{
+	const int32 NumAssets = GenerateAssetLists(Context);
+	if (NumAssets == 0 && AnimBlueprintsToRetarget.Num() == 0)
+	{
+		return;
+	}
+
+	FScopedSlowTask Progress(NumAssets + 1, LOCTEXT("GatheringBatchRetarget", "Gathering animation assets..."));
+
+	DuplicateRetargetAssets(Context, Progress);
+	DuplicateForAdditionalTargets();
+	RetargetAssets(Context, Progress);
+}
+
+bool FIKRetargetBatchOperation_Copy::ReleasePage(FIKRetargetBatchOperationContext& Context)
+{
+	TArray<UPackage*> RetargetedPackages;
+	for (const UAnimationAsset* AnimAsset : AnimationAssetsToRetarget)
+	{
+		RetargetedPackages.AddUnique(AnimAsset->GetOutermost());
+	}
+	for (const FAdditionalTargetCopies& Copies : AdditionalTargetCopies)
+	{
+		for (const TPair<UAnimationAsset*, UAnimationAsset*>& Pair : Copies.AnimAssets)
+		{
+			RetargetedPackages.AddUnique(Pair.Value->GetOutermost());
+		}
+	}
+
+	// blueprints stay loaded, generated classes may still be referenced by instances
+	TArray<UPackage*> PackagesToSave = RetargetedPackages;
+	for (const UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
+	{
+		PackagesToSave.AddUnique(AnimBlueprint->GetOutermost());
+	}
+	for (const FAdditionalTargetCopies& Copies : AdditionalTargetCopies)
+	{
+		for (const TPair<UAnimBlueprint*, UAnimBlueprint*>& Pair : Copies.Blueprints)
+		{
+			PackagesToSave.AddUnique(Pair.Value->GetOutermost());
+		}
+	}
+
+	// after DuplicateRetargetAssets the keys are the temporary duplicates, in place mode has none
+	TArray<UPackage*> TemporaryPackages;
+	if (!bInPlace)
+	{
+		for (const TPair<UAnimationAsset*, UAnimationAsset*>& Pair : DuplicatedAnimAssets)
+		{
+			if (Pair.Key)
+			{
+				TemporaryPackages.AddUnique(Pair.Key->GetOutermost());
+			}
+		}
+		for (const TPair<UAnimBlueprint*, UAnimBlueprint*>& Pair : DuplicatedBlueprints)
+		{
+			if (Pair.Key)
+			{
+				TemporaryPackages.AddUnique(Pair.Key->GetOutermost());
+			}
+		}
+	}
+
+	// the user is asked once per batch, later pages check out silently like the legacy chunks
+	if (PackagesToSave.Num() > 0 && ISourceControlModule::Get().IsEnabled())
+	{
+		if (!bCheckOutPrompted)
+		{
+			bCheckOutPrompted = true;
+			bCheckOutAccepted = FEditorFileUtils::PromptToCheckoutPackages(false, PackagesToSave);
+		}
+		else
+		{
+			FEditorFileUtils::CheckoutPackages(PackagesToSave, nullptr, false);
+		}
+	}
+
+	// declined, nothing is saved and the page stays loaded for the user, only the temporary duplicates go
+	const bool bSaving = !bCheckOutPrompted || bCheckOutAccepted;
+	if (bSaving)
+	{
+		RetargetBatchStages::SavePackages(PackagesToSave);
+	}
+
+	// anything that failed to save keeps its changes in memory
+	TArray<UPackage*> PackagesToUnload = TemporaryPackages;
+	for (UPackage* Package : RetargetedPackages)
+	{
+		if (Package->IsDirty())
+		{
+			if (bSaving)
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Retargeted package %s was not saved and stays loaded."), *Package->GetName());
+			}
+			continue;
+		}
+		PackagesToUnload.Add(Package);
+	}
+
+	// journal what made it to disk, anything still dirty is redone if the batch is resumed
+	if (Journal.IsOpen())
+	{
+		// an asset only counts as saved once its copies for the additional targets are saved too
+		auto IsSavedWithCopies = [this](UObject* Asset)
+		{
+			if (Asset->GetOutermost()->IsDirty())
+			{
+				return false;
+			}
+			for (const FAdditionalTargetCopies& Copies : AdditionalTargetCopies)
+			{
+				UObject* Copy = nullptr;
+				if (UAnimationAsset* AnimAsset = Cast<UAnimationAsset>(Asset))
+				{
+					Copy = Copies.AnimAssets.FindRef(AnimAsset);
+				}
+				else if (UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(Asset))
+				{
+					Copy = Copies.Blueprints.FindRef(AnimBlueprint);
+				}
+				if (Copy && Copy->GetOutermost()->IsDirty())
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		TArray<FName> SavedObjectPaths;
+		for (UAnimationAsset* AnimAsset : AnimationAssetsToRetarget)
+		{
+			if (IsSavedWithCopies(AnimAsset))
+			{
+				SavedObjectPaths.Add(FName(*AnimAsset->GetPathName()));
+			}
+		}
+		for (UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
+		{
+			if (IsSavedWithCopies(AnimBlueprint))
+			{
+				SavedObjectPaths.Add(FName(*AnimBlueprint->GetPathName()));
+			}
+		}
+		Journal.SetPhase(SavedObjectPaths, EIKRetargetJournalPhase::Saved);
+	}
+
+	// drop every pointer into the page before unloading it
+	Context.AssetsToRetarget.Reset();
+	AnimationAssetsToRetarget.Reset();
+	AnimBlueprintsToRetarget.Reset();
+	DuplicatedAnimAssets.Reset();
+	DuplicatedBlueprints.Reset();
+	RemappedAnimAssets.Reset();
+	AdditionalTargetCopies.Reset();
+
+	// temporary duplicates are never saved, so dirty packages must be unloaded too
+	FText ErrorMessage;
+	if (!UPackageTools::UnloadPackages(PackagesToUnload, ErrorMessage, true))
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to unload retarget page: %s"), *ErrorMessage.ToString());
+	}
+
+	return bSaving;
+}
+
+void FIKRetargetBatchOperation_Copy::GetRetargetObjectPaths(TArray<FName>& OutObjectPaths) const
+{
+	OutObjectPaths.Reserve(OutObjectPaths.Num() + AnimationAssetsToRetarget.Num() + AnimBlueprintsToRetarget.Num());
+	for (const UAnimationAsset* AnimAsset : AnimationAssetsToRetarget)
+	{
+		OutObjectPaths.Add(FName(*AnimAsset->GetPathName()));
+	}
+	for (const UAnimBlueprint* AnimBlueprint : AnimBlueprintsToRetarget)
+	{
+		OutObjectPaths.Add(FName(*AnimBlueprint->GetPathName()));
+	}
 }
 
 /**
@@ -8,8 +8,22 @@
 #include "CoreMinimal.h"
 #include "EditorAnimUtils.h"
 #include "IKRigEditor/Public/RetargetEditor/IKRetargetBatchOperation.h"
+#include "IKRetargetBatchJournal.h"
 
 class UIKRetargeter;
+class USkeletalMesh;
+class UAnimSequence;
+class UIKRetargetProcessor;
+
+/** Extra target of a batch, retargeted from the same source animation into new assets */
+struct FIKRetargetAdditionalTarget
+{
+	USkeletalMesh* TargetMesh = nullptr;
+	UIKRetargeter* IKRetargetAsset = nullptr;
+
+	/** Where the retargeted copies are created and how they are named */
+	EditorAnimUtils::FNameDuplicationRule NameRule;
+};
 
 //** Encapsulate ability to batch duplicate and retarget a set of animation assets */
 struct FIKRetargetBatchOperation_Copy
@@ -20,8 +34,81 @@ public:
 	/* Actually run the process to duplicate and retarget the assets for the given context */
 	void RunRetarget(FIKRetargetBatchOperationContext& Context);
 
+	/**
+	* Run the process on assets known only by their registry data.
+	* Assets are loaded page by page into Context.AssetsToRetarget, and each page is saved and unloaded before the next one.
+	*/
+	void RunRetarget(FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& AssetsToLoad);
+
+	/**
+	* Retarget the original assets directly, reading the source animation from transient in-memory snapshots.
+	* When false, every asset is duplicated into Context.NameRule.FolderPath first and the folder is deleted afterwards.
+	*/
+	bool bInPlace = true;
+
+	/**
+	* Save and unload every page of RetargetSkeleton.PageSize assets, whatever the size of the batch. A memory budget
+	* turns it on as well. When false the whole batch stays loaded and is left for the user to save.
+	*/
+	bool bSavePages = false;
+
+	/* Tells the journal of this batch apart from other batches sharing the same context */
+	FString BatchTag;
+
+	/**
+	* Also retarget copies of the batch to each of these targets. Every source frame is evaluated once and fed to the
+	* processors of all targets, the context target still retargets the original assets.
+	*/
+	TArray<FIKRetargetAdditionalTarget> AdditionalTargets;
+
+	/* Assets loaded per page, from RetargetSkeleton.PageSize or the memory budget */
+	static int32 GetPageSize();
+
+	/* Object paths of everything retargeted by the last run */
+	const TSet<FName>& GetProcessedAssets() const { return ProcessedAssets; }
+
 private:
 
+	/**
+	* Initialize the retarget processors before any asset is loaded or modified, so a retargeter that can't run never
+	* leaves stripped assets behind. Additional targets whose processor fails are skipped and get no copies.
+	* Processors are rooted until ReleaseProcessors.
+	* @return	false if the context target can't be retargeted
+	*/
+	bool InitializeProcessors(const FIKRetargetBatchOperationContext& Context);
+
+	void ReleaseProcessors();
+
+	/* Take a transient snapshot of every sequence to retarget, used as animation source by the in-place mode */
+	void SnapshotRetargetAssets();
+
+	/* Let the snapshots be garbage collected once the animation is converted */
+	void ReleaseSnapshots();
+
+	/* Duplicate and retarget the assets currently in Context.AssetsToRetarget, skipping any already processed */
+	void RetargetPage(const FIKRetargetBatchOperationContext& Context);
+
+	/**
+	* Save the assets retargeted by the last page and unload them with their temporary duplicates
+	* @return	false if the user declined to check out the batch, the page then stays loaded and unsaved
+	*/
+	bool ReleasePage(FIKRetargetBatchOperationContext& Context);
+
+	/* Object paths of the assets and blueprints in the current retarget lists */
+	void GetRetargetObjectPaths(TArray<FName>& OutObjectPaths) const;
+
+	/** How an asset ended up in the retarget lists, for the discovery statistics */
+	enum class EAssetDiscovery : uint8
+	{
+		Selected,
+		MontageSegment,
+		PreviewPose,
+		ParentBlueprint,
+		BlueprintReference,
+		AnimReference,
+		Num
+	};
+
 	/**
 	* Initialize set of referenced assets to retarget.
 	* @return	Number of assets that need retargeting.
@@ -31,9 +118,18 @@ private:
 	/* Duplicate all the assets to retarget */
 	void DuplicateRetargetAssets(const FIKRetargetBatchOperationContext& Context, FScopedSlowTask& Progress);
 
+	/* Duplicate the assets to retarget once per additional target, before the originals are modified */
+	void DuplicateForAdditionalTargets();
+
 	/* Retarget skeleton and animation on all the duplicates */
 	void RetargetAssets(const FIKRetargetBatchOperationContext& Context, FScopedSlowTask& Progress);
 
+	/* Move animation assets to the target skeleton and strip the tracks the conversion rewrites, leaving their brackets open */
+	static void PrepareAnimAssets(const TArray<UAnimationAsset*>& AnimAssets, USkeletalMesh* TargetMesh, const TMap<UAnimationAsset*, UAnimationAsset*>* ReferenceRemap);
+
+	/* Notify the edits of everything but sequences, whose brackets stay open for RetargetBatchStages::CompressAnimSequences */
+	static void FinishAnimAssets(const TArray<UAnimationAsset*>& AnimAssets, TArray<UAnimSequence*>& OutSequencesToCompress);
+
 	/* Convert animation on all the duplicates */
 	void ConvertAnimation(const FIKRetargetBatchOperationContext& Context, FScopedSlowTask& Progress);
 
@@ -75,12 +171,43 @@ private:
 	TArray<UAnimationAsset*>	AnimationAssetsToRetarget;
 	TArray<UAnimBlueprint*>		AnimBlueprintsToRetarget;
 
-	/** Lists of original assets map to duplicate assets */
+	/** Lists of original assets map to duplicate assets, in place mode maps transient snapshots to originals */
 	TMap<UAnimationAsset*, UAnimationAsset*>	DuplicatedAnimAssets;
 	TMap<UAnimBlueprint*, UAnimBlueprint*>		DuplicatedBlueprints;
 
 	TMap<UAnimationAsset*, UAnimationAsset*>	RemappedAnimAssets;
 
+	/** Copies made for one additional target, original asset to copy */
+	struct FAdditionalTargetCopies
+	{
+		TMap<UAnimationAsset*, UAnimationAsset*> AnimAssets;
+		TMap<UAnimBlueprint*, UAnimBlueprint*> Blueprints;
+	};
+
+	/** Copies of the current page, one entry per additional target */
+	TArray<FAdditionalTargetCopies> AdditionalTargetCopies;
+
+	/** Object paths of everything retargeted so far, so later pages don't process shared references twice */
+	TSet<FName> ProcessedAssets;
+
+	/** Processor of the context target, shared by every page of the run */
+	UIKRetargetProcessor* RetargetProcessor = nullptr;
+
+	/** Processor of each additional target, null for a target that is skipped */
+	TArray<UIKRetargetProcessor*> AdditionalProcessors;
+
+	/** Measured cost of the current run, fed back to FIKRetargetBatchPlanner */
+	int32 RetargetedAssetTargets = 0;
+	int64 ConvertedFrameBones = 0;
+	double ConvertSeconds = 0.0;
+
+	/** Whether the user was asked to check out the packages of this batch, and accepted */
+	bool bCheckOutPrompted = false;
+	bool bCheckOutAccepted = false;
+
+	/** Progress of a paged batch, lets an interrupted run resume where it stopped */
+	FIKRetargetBatchJournal Journal;
+
 	/** If we only chose one object to retarget store it here */
 	UObject* SingleTargetObject = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IKRetargetBatchPlanner.h"
+#include "IKRigEditor/Public/RetargetEditor/IKRetargetBatchOperation.h"
+#include "IKRetargetBatchOperation_Copy.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimBlueprint.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "ISourceControlState.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "RetargetBatchStages.h"
+
+#define LOCTEXT_NAMESPACE "IKRetargetBatchPlanner"
+
+namespace IKRetargetBatchPlanner
+{
+	static const TCHAR* ConfigSection = TEXT("RetargetSkeleton.BatchPlanner");
+
+	/** Bytes of raw position, rotation and scale keys per bone and frame */
+	static const int64 RawKeyBytes = sizeof(FVector3f) + sizeof(FQuat4f) + sizeof(FVector3f);
+
+	static double GetCost(const TCHAR* Key, double DefaultValue)
+	{
+		double Value = DefaultValue;
+		GConfig->GetDouble(ConfigSection, Key, Value, GEditorPerProjectIni);
+		return Value > 0.0 ? Value : DefaultValue;
+	}
+
+	/** Averages a new measurement into the stored figure, so one unusual batch doesn't throw off the next plan */
+	static void RecordCost(const TCHAR* Key, double Measured)
+	{
+		double Stored = 0.0;
+		const bool bHasStored = GConfig->GetDouble(ConfigSection, Key, Stored, GEditorPerProjectIni) && Stored > 0.0;
+		GConfig->SetDouble(ConfigSection, Key, bHasStored ? 0.5 * (Stored + Measured) : Measured, GEditorPerProjectIni);
+	}
+
+	static int32 GetNumFrames(const FAssetData& AssetData)
+	{
+		int32 NumFrames = 0;
+		if (AssetData.GetTagValue(TEXT("NumberOfSampledKeys"), NumFrames) || AssetData.GetTagValue(TEXT("NumFrames"), NumFrames))
+		{
+			return NumFrames;
+		}
+
+		// otherwise from the length and the rate the sequence was sampled at on import
+		float SequenceLength = 0.f;
+		if (!AssetData.GetTagValue(TEXT("SequenceLength"), SequenceLength))
+		{
+			return 0;
+		}
+
+		int32 FrameRate = 0;
+		if (!AssetData.GetTagValue(TEXT("ImportResampleFramerate"), FrameRate) || FrameRate <= 0)
+		{
+			FrameRate = 30;
+		}
+		return FMath::RoundToInt(SequenceLength * FrameRate) + 1;
+	}
+
+	static bool NeedsCheckOut(const FString& Filename)
+	{
+		ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+		if (SourceControlModule.IsEnabled())
+		{
+			// cached state only, planning never talks to the server
+			const FSourceControlStatePtr State = SourceControlModule.GetProvider().GetState(Filename, EStateCacheUsage::Use);
+			if (State.IsValid() && State->IsSourceControlled())
+			{
+				return !State->IsCheckedOut() && !State->IsAdded();
+			}
+		}
+		return IFileManager::Get().IsReadOnly(*Filename);
+	}
+}
+
+FText FIKRetargetBatchPlan::GetSummary() const
+{
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("Assets"), FText::AsNumber(Assets.Num()));
+	Args.Add(TEXT("Sequences"), FText::AsNumber(NumSequences));
+	Args.Add(TEXT("Frames"), FText::AsNumber(TotalFrames));
+	Args.Add(TEXT("Blueprints"), FText::AsNumber(NumBlueprints));
+	Args.Add(TEXT("CheckOut"), FText::AsNumber(NumPackagesToCheckOut));
+	Args.Add(TEXT("SourceBones"), FText::AsNumber(NumSourceBones));
+	Args.Add(TEXT("TargetBones"), FText::AsNumber(NumTargetBones));
+	Args.Add(TEXT("Targets"), FText::AsNumber(NumTargets));
+	Args.Add(TEXT("Sockets"), FText::AsNumber(NumSocketsToTransfer));
+	Args.Add(TEXT("Pages"), FText::AsNumber(NumPages));
+	Args.Add(TEXT("Time"), FText::FromString(FTimespan::FromSeconds(EstimatedSeconds).ToString(TEXT("%h:%m:%s"))));
+	Args.Add(TEXT("Memory"), FText::AsMemory(EstimatedPeakBytes));
+	return FText::Format(LOCTEXT("PlanSummary",
+		"{Assets} assets to retarget to {Targets} target(s), in {Pages} page(s)\n"
+		"{Sequences} sequences, {Frames} frames, {SourceBones} source bones, {TargetBones} target bones\n"
+		"{Blueprints} animation blueprints to compile\n"
+		"{CheckOut} packages to check out\n"
+		"{Sockets} sockets to transfer\n"
+		"Estimated time {Time}, estimated peak memory {Memory}"), Args);
+}
+
+bool FIKRetargetBatchPlan::SaveCsv(const FString& Filename) const
+{
+	FString Csv = TEXT("ObjectPath,Class,Frames,PackageBytes,Blueprint,NeedsCheckOut\n");
+	for (const FIKRetargetPlannedAsset& Asset : Assets)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%lld,%d,%d\n"), *Asset.ObjectPath.ToString(), *Asset.AssetClass.ToString(),
+			Asset.NumFrames, Asset.PackageBytes, Asset.bIsBlueprint ? 1 : 0, Asset.bNeedsCheckOut ? 1 : 0);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *Filename);
+}
+
+FIKRetargetBatchPlan FIKRetargetBatchPlanner::Plan(const FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& Assets, int32 NumAdditionalTargets)
+{
+	FIKRetargetBatchPlan Plan;
+	if (!Context.SourceMesh || !Context.TargetMesh)
+	{
+		return Plan;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// same closure as GenerateAssetLists, through package dependencies instead of loaded references:
+	// montages of the batch always bring their segments and blueprints their parent chain, everything else only when remapping
+	TArray<FAssetData> Closure = Assets;
+	TSet<FName> KnownAssets;
+	for (const FAssetData& AssetData : Assets)
+	{
+		KnownAssets.Add(AssetData.ObjectPath);
+	}
+
+	TArray<FName> Dependencies;
+	TArray<FAssetData> DependencyAssets;
+	for (int32 AssetIndex = 0; AssetIndex < Closure.Num(); ++AssetIndex)
+	{
+		UClass* AssetClass = Closure[AssetIndex].GetClass();
+		const bool bIsBlueprint = AssetClass && AssetClass->IsChildOf(UAnimBlueprint::StaticClass());
+		const bool bIsMontage = AssetClass && AssetClass->IsChildOf(UAnimMontage::StaticClass());
+		const bool bIsSelected = AssetIndex < Assets.Num();
+		if (!Context.bRemapReferencedAssets && !bIsBlueprint && !(bIsSelected && bIsMontage))
+		{
+			continue;
+		}
+
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(Closure[AssetIndex].PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		for (const FName& Dependency : Dependencies)
+		{
+			DependencyAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(Dependency, DependencyAssets);
+			for (const FAssetData& DependencyAsset : DependencyAssets)
+			{
+				UClass* DependencyClass = DependencyAsset.GetClass();
+				const bool bDependencyIsBlueprint = DependencyClass && DependencyClass->IsChildOf(UAnimBlueprint::StaticClass());
+				const bool bDependencyIsAnimation = DependencyClass && DependencyClass->IsChildOf(UAnimationAsset::StaticClass());
+
+				// without remapping, blueprints only bring their parents
+				const bool bFollow = Context.bRemapReferencedAssets ? (bDependencyIsBlueprint || bDependencyIsAnimation) : (bIsBlueprint ? bDependencyIsBlueprint : bDependencyIsAnimation);
+				if (bFollow && !KnownAssets.Contains(DependencyAsset.ObjectPath))
+				{
+					KnownAssets.Add(DependencyAsset.ObjectPath);
+					Closure.Add(DependencyAsset);
+				}
+			}
+		}
+	}
+
+	Plan.NumSourceBones = Context.SourceMesh->GetRefSkeleton().GetNum();
+	Plan.NumTargetBones = Context.TargetMesh->GetRefSkeleton().GetNum();
+	Plan.NumTargets = 1 + NumAdditionalTargets;
+	Plan.NumSocketsToTransfer = RetargetBatchStages::TransferSockets(Context.SourceMesh->GetSkeleton(), Context.TargetMesh->GetSkeleton(), true);
+
+	const double MemoryPerDiskByte = IKRetargetBatchPlanner::GetCost(TEXT("MemoryPerDiskByte"), 4.0);
+
+	TArray<int64> ResidentBytes;
+	Plan.Assets.Reserve(Closure.Num());
+	for (const FAssetData& AssetData : Closure)
+	{
+		FIKRetargetPlannedAsset& Asset = Plan.Assets.AddDefaulted_GetRef();
+		Asset.ObjectPath = AssetData.ObjectPath;
+		Asset.AssetClass = AssetData.AssetClass;
+
+		UClass* AssetClass = AssetData.GetClass();
+		Asset.bIsBlueprint = AssetClass && AssetClass->IsChildOf(UAnimBlueprint::StaticClass());
+		if (AssetClass && AssetClass->IsChildOf(UAnimSequence::StaticClass()))
+		{
+			Asset.NumFrames = IKRetargetBatchPlanner::GetNumFrames(AssetData);
+			++Plan.NumSequences;
+			Plan.TotalFrames += Asset.NumFrames;
+		}
+		Plan.NumBlueprints += Asset.bIsBlueprint ? 1 : 0;
+
+		FString Filename;
+		if (FPackageName::TryConvertLongPackageNameToFilename(AssetData.PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+		{
+			Asset.PackageBytes = FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+			Asset.bNeedsCheckOut = IKRetargetBatchPlanner::NeedsCheckOut(Filename);
+			Plan.NumPackagesToCheckOut += Asset.bNeedsCheckOut ? 1 : 0;
+		}
+
+		// the loaded asset and its copies, plus the source snapshot and target keys staged for conversion
+		ResidentBytes.Add(int64(Asset.PackageBytes * MemoryPerDiskByte) * Plan.NumTargets
+			+ int64(Asset.NumFrames) * (Plan.NumSourceBones + Plan.NumTargetBones * Plan.NumTargets) * IKRetargetBatchPlanner::RawKeyBytes);
+	}
+
+	// paging follows RunRetarget, the heaviest page is bounded by the heaviest assets that fit in one
+	const int32 PageSize = FIKRetargetBatchOperation_Copy::GetPageSize();
+	Plan.NumPages = FMath::Max(FMath::DivideAndRoundUp(Assets.Num(), PageSize), 1);
+	ResidentBytes.Sort(TGreater<int64>());
+	for (int32 AssetIndex = 0; AssetIndex < ResidentBytes.Num() && AssetIndex < PageSize; ++AssetIndex)
+	{
+		Plan.EstimatedPeakBytes += ResidentBytes[AssetIndex];
+	}
+
+	const int64 FrameBones = Plan.TotalFrames * Plan.NumTargetBones * Plan.NumTargets;
+	Plan.EstimatedSeconds = FrameBones * IKRetargetBatchPlanner::GetCost(TEXT("SecondsPerFrameBone"), 2e-6)
+		+ Plan.Assets.Num() * Plan.NumTargets * IKRetargetBatchPlanner::GetCost(TEXT("SecondsPerAsset"), 0.05);
+
+	UE_LOG(LogRetargetSkeleton, Display, TEXT("Retarget plan: %s"), *Plan.GetSummary().ToString().Replace(TEXT("\n"), TEXT(", ")));
+	return Plan;
+}
+
+void FIKRetargetBatchPlanner::RecordBatch(int32 NumAssetTargets, int64 FrameBones, double ConvertSeconds, double TotalSeconds)
+{
+	// worker processes share the ini and run side by side, only the editor records
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
+	if (FrameBones > 0 && ConvertSeconds > 0.0)
+	{
+		IKRetargetBatchPlanner::RecordCost(TEXT("SecondsPerFrameBone"), ConvertSeconds / FrameBones);
+	}
+
+	// loading, saving, compression and blueprint compilation, everything but the conversion itself
+	// Plan scales it by assets and targets, so it is stored per asset per target
+	if (NumAssetTargets > 0 && TotalSeconds > ConvertSeconds)
+	{
+		IKRetargetBatchPlanner::RecordCost(TEXT("SecondsPerAsset"), (TotalSeconds - ConvertSeconds) / NumAssetTargets);
+	}
+
+	GConfig->Flush(false, GEditorPerProjectIni);
+}
+
+#undef LOCTEXT_NAMESPACE
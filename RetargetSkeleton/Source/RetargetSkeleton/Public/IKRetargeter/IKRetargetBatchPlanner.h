@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+struct FIKRetargetBatchOperationContext;
+
+/** One asset an IK retarget batch would touch, as far as the asset registry can tell */
+struct FIKRetargetPlannedAsset
+{
+	FName ObjectPath;
+	FName AssetClass;
+	/** Sampled frames, 0 for assets without bone tracks of their own */
+	int32 NumFrames = 0;
+	/** Size of the package on disk */
+	int64 PackageBytes = 0;
+	bool bIsBlueprint = false;
+	/** Package file is read only or not checked out */
+	bool bNeedsCheckOut = false;
+};
+
+/** Dry run of an IK retarget batch, see FIKRetargetBatchPlanner */
+struct FIKRetargetBatchPlan
+{
+	TArray<FIKRetargetPlannedAsset> Assets;
+
+	int32 NumSourceBones = 0;
+	int32 NumTargetBones = 0;
+	int32 NumTargets = 1;
+	int32 NumSequences = 0;
+	int32 NumBlueprints = 0;
+	int32 NumPackagesToCheckOut = 0;
+	int32 NumSocketsToTransfer = 0;
+	int32 NumPages = 1;
+	int64 TotalFrames = 0;
+
+	double EstimatedSeconds = 0.0;
+	/** Memory the batch adds on top of the editor, for its heaviest page */
+	int64 EstimatedPeakBytes = 0;
+
+	/** Multi-line summary for the user */
+	FText GetSummary() const;
+
+	/** Writes one row per asset */
+	bool SaveCsv(const FString& Filename) const;
+};
+
+/**
+ * Estimates the cost of an IK retarget batch from asset registry data only, nothing is loaded or modified.
+ * The asset closure mirrors FIKRetargetBatchOperation_Copy::GenerateAssetLists through registry dependencies, and costs
+ * come from per-frame and per-asset figures stored in the editor per-project ini. Every finished batch updates them.
+ */
+class FIKRetargetBatchPlanner
+{
+public:
+	/**
+	 * @param	Context					Batch to plan, source and target meshes must be set
+	 * @param	Assets					Registry data of the assets the batch starts from
+	 * @param	NumAdditionalTargets	Targets retargeted into copies in the same pass
+	 */
+	static FIKRetargetBatchPlan Plan(const FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& Assets, int32 NumAdditionalTargets = 0);
+
+	/**
+	 * Folds the measured cost of a finished batch into the stored figures
+	 *
+	 * @param	NumAssetTargets		Assets and blueprints retargeted by this run, counted once per target
+	 * @param	FrameBones			Sum over converted sequences of frames times target bones
+	 * @param	ConvertSeconds		Time spent converting animation
+	 * @param	TotalSeconds		Time spent on the whole batch
+	 */
+	static void RecordBatch(int32 NumAssetTargets, int64 FrameBones, double ConvertSeconds, double TotalSeconds);
+};
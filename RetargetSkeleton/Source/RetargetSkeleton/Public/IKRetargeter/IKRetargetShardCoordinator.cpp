@@ -0,0 +1,450 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IKRetargetShardCoordinator.h"
+#include "IKRetargetBatchPlanner.h"
+#include "IKRigEditor/Public/RetargetEditor/IKRetargetBatchOperation.h"
+#include "Retargeter/IKRetargeter.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlOperation.h"
+#include "SourceControlOperations.h"
+#include "SourceControlHelpers.h"
+#include "PackageTools.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "RetargetBatchStages.h"
+
+#define LOCTEXT_NAMESPACE "IKRetargetShardCoordinator"
+
+static TAutoConsoleVariable<int32> CVarRetargetWorkerProcesses(
+	TEXT("RetargetSkeleton.WorkerProcesses"),
+	0,
+	TEXT("When above 1, the IK skeleton retarget splits its assets over this many worker editor processes instead of running in the editor."));
+
+namespace IKRetargetShardCoordinator
+{
+	/** Fewest assets per worker worth the start up cost of an editor process */
+	static const int32 MinAssetsPerWorker = 50;
+
+	static bool SaveJson(const TSharedRef<FJsonObject>& JsonObject, const FString& Filename)
+	{
+		FString JsonText;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+		return FJsonSerializer::Serialize(JsonObject, Writer) && FFileHelper::SaveStringToFile(JsonText, *Filename);
+	}
+
+	static TSharedPtr<FJsonObject> LoadJson(const FString& Filename)
+	{
+		FString JsonText;
+		if (!FFileHelper::LoadFileToString(JsonText, *Filename))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> JsonObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+		return FJsonSerializer::Deserialize(Reader, JsonObject) ? JsonObject : nullptr;
+	}
+
+	static bool IsDirty(const UObject* Object)
+	{
+		return Object && Object->GetOutermost()->IsDirty();
+	}
+}
+
+bool FIKRetargetShardManifest::Save(const FString& Filename) const
+{
+	TArray<TSharedPtr<FJsonValue>> AssetValues;
+	for (const FString& Asset : Assets)
+	{
+		AssetValues.Add(MakeShared<FJsonValueString>(Asset));
+	}
+
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("SourceMesh"), SourceMesh);
+	JsonObject->SetStringField(TEXT("TargetMesh"), TargetMesh);
+	JsonObject->SetStringField(TEXT("Retargeter"), Retargeter);
+	JsonObject->SetStringField(TEXT("FolderPath"), FolderPath);
+	JsonObject->SetBoolField(TEXT("RemapReferencedAssets"), bRemapReferencedAssets);
+	JsonObject->SetBoolField(TEXT("InPlace"), bInPlace);
+	JsonObject->SetArrayField(TEXT("Assets"), AssetValues);
+	return IKRetargetShardCoordinator::SaveJson(JsonObject, Filename);
+}
+
+bool FIKRetargetShardManifest::Load(const FString& Filename)
+{
+	const TSharedPtr<FJsonObject> JsonObject = IKRetargetShardCoordinator::LoadJson(Filename);
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	SourceMesh = JsonObject->GetStringField(TEXT("SourceMesh"));
+	TargetMesh = JsonObject->GetStringField(TEXT("TargetMesh"));
+	Retargeter = JsonObject->GetStringField(TEXT("Retargeter"));
+	FolderPath = JsonObject->GetStringField(TEXT("FolderPath"));
+	bRemapReferencedAssets = JsonObject->GetBoolField(TEXT("RemapReferencedAssets"));
+	bInPlace = JsonObject->GetBoolField(TEXT("InPlace"));
+	return JsonObject->TryGetStringArrayField(TEXT("Assets"), Assets);
+}
+
+bool FIKRetargetShardResult::Save(const FString& Filename) const
+{
+	TArray<TSharedPtr<FJsonValue>> RetargetedValues;
+	for (const FString& Asset : Retargeted)
+	{
+		RetargetedValues.Add(MakeShared<FJsonValueString>(Asset));
+	}
+
+	TSharedRef<FJsonObject> FailedObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, FString>& Pair : Failed)
+	{
+		FailedObject->SetStringField(Pair.Key, Pair.Value);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> CurveNameValues;
+	for (const FString& CurveName : CurveNames)
+	{
+		CurveNameValues.Add(MakeShared<FJsonValueString>(CurveName));
+	}
+
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetArrayField(TEXT("Retargeted"), RetargetedValues);
+	JsonObject->SetObjectField(TEXT("Failed"), FailedObject);
+	JsonObject->SetArrayField(TEXT("CurveNames"), CurveNameValues);
+	return IKRetargetShardCoordinator::SaveJson(JsonObject, Filename);
+}
+
+bool FIKRetargetShardResult::Load(const FString& Filename)
+{
+	const TSharedPtr<FJsonObject> JsonObject = IKRetargetShardCoordinator::LoadJson(Filename);
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	JsonObject->TryGetStringArrayField(TEXT("Retargeted"), Retargeted);
+	JsonObject->TryGetStringArrayField(TEXT("CurveNames"), CurveNames);
+
+	const TSharedPtr<FJsonObject>* FailedObject = nullptr;
+	if (JsonObject->TryGetObjectField(TEXT("Failed"), FailedObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*FailedObject)->Values)
+		{
+			Failed.Add(Pair.Key, Pair.Value->AsString());
+		}
+	}
+	return true;
+}
+
+FString FIKRetargetShardResult::GetResultFilename(const FString& ManifestFilename)
+{
+	return FPaths::GetPath(ManifestFilename) / FPaths::GetBaseFilename(ManifestFilename) + TEXT(".result.json");
+}
+
+int32 FIKRetargetShardCoordinator::GetNumWorkers()
+{
+	return FMath::Max(CVarRetargetWorkerProcesses.GetValueOnGameThread(), 0);
+}
+
+void FIKRetargetShardCoordinator::BuildShards(const TArray<FAssetData>& Assets, int32 NumShards, TArray<TArray<FAssetData>>& OutShards)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TMap<FName, int32> PackageToAsset;
+	PackageToAsset.Reserve(Assets.Num());
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(Assets.Num());
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		PackageToAsset.Add(Assets[AssetIndex].PackageName, AssetIndex);
+		Parents[AssetIndex] = AssetIndex;
+	}
+
+	auto FindRoot = [&Parents](int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+		return Index;
+	};
+
+	// a montage, blend space or blueprint and whatever it references in the batch must be retargeted by the same worker
+	TArray<FName> Dependencies;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(Assets[AssetIndex].PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		for (const FName& Dependency : Dependencies)
+		{
+			if (const int32* DependencyIndex = PackageToAsset.Find(Dependency))
+			{
+				Parents[FindRoot(*DependencyIndex)] = FindRoot(AssetIndex);
+			}
+		}
+	}
+
+	TMap<int32, TArray<int32>> Groups;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		Groups.FindOrAdd(FindRoot(AssetIndex)).Add(AssetIndex);
+	}
+
+	TArray<TArray<int32>> SortedGroups;
+	Groups.GenerateValueArray(SortedGroups);
+	SortedGroups.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() > B.Num(); });
+
+	// largest groups first, each onto the lightest shard so far
+	OutShards.Reset();
+	OutShards.SetNum(NumShards);
+	for (const TArray<int32>& Group : SortedGroups)
+	{
+		int32 LightestShard = 0;
+		for (int32 ShardIndex = 1; ShardIndex < NumShards; ++ShardIndex)
+		{
+			if (OutShards[ShardIndex].Num() < OutShards[LightestShard].Num())
+			{
+				LightestShard = ShardIndex;
+			}
+		}
+
+		for (int32 AssetIndex : Group)
+		{
+			OutShards[LightestShard].Add(Assets[AssetIndex]);
+		}
+	}
+
+	OutShards.RemoveAll([](const TArray<FAssetData>& Shard) { return Shard.Num() == 0; });
+}
+
+bool FIKRetargetShardCoordinator::Run(const FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& Assets, bool bInPlace)
+{
+	const int32 NumWorkers = FMath::Min(GetNumWorkers(), Assets.Num() / IKRetargetShardCoordinator::MinAssetsPerWorker);
+	if (NumWorkers < 2 || !Context.IsValid())
+	{
+		return false;
+	}
+
+	USkeleton* SourceSkeleton = Context.SourceMesh->GetSkeleton();
+	USkeleton* TargetSkeleton = Context.TargetMesh->GetSkeleton();
+
+	// workers load everything from disk, so unsaved edits in this editor would be silently ignored
+	bool bHasUnsavedChanges = IKRetargetShardCoordinator::IsDirty(Context.SourceMesh) || IKRetargetShardCoordinator::IsDirty(Context.TargetMesh)
+		|| IKRetargetShardCoordinator::IsDirty(Context.IKRetargetAsset) || IKRetargetShardCoordinator::IsDirty(SourceSkeleton) || IKRetargetShardCoordinator::IsDirty(TargetSkeleton);
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num() && !bHasUnsavedChanges; ++AssetIndex)
+	{
+		bHasUnsavedChanges = Assets[AssetIndex].IsAssetLoaded() && IKRetargetShardCoordinator::IsDirty(Assets[AssetIndex].GetAsset());
+	}
+	if (bHasUnsavedChanges)
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Retargeting in this editor, worker processes can't see unsaved changes to the batch assets."));
+		return false;
+	}
+
+	TArray<TArray<FAssetData>> Shards;
+	BuildShards(Assets, NumWorkers, Shards);
+
+	// workers run without source control, so everything they may save is checked out up front: the closure
+	// GenerateAssetLists pulls in, as the planner finds it through the registry
+	const FIKRetargetBatchPlan Plan = FIKRetargetBatchPlanner::Plan(Context, Assets);
+	TArray<FString> PackageFilenames;
+	for (const FIKRetargetPlannedAsset& Asset : Plan.Assets)
+	{
+		if (Asset.bNeedsCheckOut)
+		{
+			PackageFilenames.AddUnique(SourceControlHelpers::PackageFilename(FPackageName::ObjectPathToPackageName(Asset.ObjectPath.ToString())));
+		}
+	}
+
+	if (PackageFilenames.Num() > 0)
+	{
+		// asked once, as the in-editor batch does, a declined or failed check-out cancels the batch before any worker starts
+		bool bCheckedOut = false;
+		if (ISourceControlModule::Get().IsEnabled())
+		{
+			const FText Question = FText::Format(LOCTEXT("ShardCheckOutPrompt", "Retargeting in worker processes needs {0} packages checked out. Check them out now?"), FText::AsNumber(PackageFilenames.Num()));
+			if (FMessageDialog::Open(EAppMsgType::YesNo, Question) == EAppReturnType::Yes)
+			{
+				bCheckedOut = ISourceControlModule::Get().GetProvider().Execute(ISourceControlOperation::Create<FCheckOut>(), PackageFilenames) == ECommandResult::Succeeded;
+			}
+			else
+			{
+				UE_LOG(LogRetargetSkeleton, Warning, TEXT("Check-out declined, retarget batch cancelled."));
+				return true;
+			}
+		}
+
+		if (!bCheckedOut)
+		{
+			UE_LOG(LogRetargetSkeleton, Error, TEXT("Could not check out or write %d packages of the batch, retarget batch cancelled."), PackageFilenames.Num());
+			FNotificationInfo Notification(LOCTEXT("ShardCheckOutFailed", "Could not check out the batch for the worker processes, nothing was retargeted. See Output for details."));
+			Notification.ExpireDuration = 5.f;
+			FSlateNotificationManager::Get().AddNotification(Notification);
+			return true;
+		}
+	}
+
+	const FString ShardDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("RetargetSkeleton") / TEXT("Shards") / FDateTime::Now().ToString());
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+	TArray<FString> ManifestFilenames;
+	TArray<FProcHandle> Workers;
+	for (int32 ShardIndex = 0; ShardIndex < Shards.Num(); ++ShardIndex)
+	{
+		FIKRetargetShardManifest Manifest;
+		Manifest.SourceMesh = Context.SourceMesh->GetPathName();
+		Manifest.TargetMesh = Context.TargetMesh->GetPathName();
+		Manifest.Retargeter = Context.IKRetargetAsset->GetPathName();
+		Manifest.FolderPath = Context.NameRule.FolderPath / FString::Printf(TEXT("Shard%d"), ShardIndex);
+		Manifest.bRemapReferencedAssets = Context.bRemapReferencedAssets;
+		Manifest.bInPlace = bInPlace;
+		for (const FAssetData& AssetData : Shards[ShardIndex])
+		{
+			Manifest.Assets.Add(AssetData.ObjectPath.ToString());
+		}
+
+		const FString ManifestFilename = ShardDirectory / FString::Printf(TEXT("Shard%d.json"), ShardIndex);
+		if (!Manifest.Save(ManifestFilename))
+		{
+			UE_LOG(LogRetargetSkeleton, Error, TEXT("Failed to write retarget shard manifest %s"), *ManifestFilename);
+			continue;
+		}
+
+		const FString Params = FString::Printf(TEXT("\"%s\" -run=RetargetSkeletonWorker -Manifest=\"%s\" -abslog=\"%s\" -unattended -nullrhi -nosplash -nosourcecontrol"),
+			*ProjectFile, *ManifestFilename, *FPaths::ChangeExtension(ManifestFilename, TEXT("log")));
+		FProcHandle Worker = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Worker.IsValid())
+		{
+			UE_LOG(LogRetargetSkeleton, Error, TEXT("Failed to start a retarget worker for %s"), *ManifestFilename);
+			continue;
+		}
+
+		ManifestFilenames.Add(ManifestFilename);
+		Workers.Add(Worker);
+	}
+
+	if (Workers.Num() == 0)
+	{
+		return false;
+	}
+
+	UE_LOG(LogRetargetSkeleton, Display, TEXT("Retargeting %d assets in %d worker processes, logs in %s"), Assets.Num(), Workers.Num(), *ShardDirectory);
+
+	// wait on the workers, cancelling kills them and keeps whatever they already saved
+	{
+		FScopedSlowTask Progress((float)Workers.Num(), LOCTEXT("WaitingForWorkers", "Retargeting in worker processes..."));
+		Progress.MakeDialog(true);
+
+		TArray<bool> Finished;
+		Finished.SetNumZeroed(Workers.Num());
+		int32 NumFinished = 0;
+		while (NumFinished < Workers.Num())
+		{
+			if (Progress.ShouldCancel())
+			{
+				for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+				{
+					if (!Finished[WorkerIndex])
+					{
+						FPlatformProcess::TerminateProc(Workers[WorkerIndex], true);
+					}
+				}
+				break;
+			}
+
+			float FinishedThisTick = 0.f;
+			for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+			{
+				if (!Finished[WorkerIndex] && !FPlatformProcess::IsProcRunning(Workers[WorkerIndex]))
+				{
+					Finished[WorkerIndex] = true;
+					++NumFinished;
+					FinishedThisTick += 1.f;
+				}
+			}
+
+			Progress.EnterProgressFrame(FinishedThisTick);
+			FPlatformProcess::Sleep(0.25f);
+		}
+	}
+
+	// merge shard results, a worker that left none failed its whole shard
+	FIKRetargetShardResult MergedResult;
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+	{
+		int32 ReturnCode = 0;
+		FPlatformProcess::GetProcReturnCode(Workers[WorkerIndex], &ReturnCode);
+		FPlatformProcess::CloseProc(Workers[WorkerIndex]);
+
+		FIKRetargetShardResult ShardResult;
+		if (ShardResult.Load(FIKRetargetShardResult::GetResultFilename(ManifestFilenames[WorkerIndex])))
+		{
+			MergedResult.Retargeted.Append(ShardResult.Retargeted);
+			MergedResult.Failed.Append(ShardResult.Failed);
+			MergedResult.CurveNames.Append(ShardResult.CurveNames);
+			continue;
+		}
+
+		FIKRetargetShardManifest Manifest;
+		Manifest.Load(ManifestFilenames[WorkerIndex]);
+		const FString Reason = FString::Printf(TEXT("Worker exited with code %d without a result, see %s"), ReturnCode, *FPaths::ChangeExtension(ManifestFilenames[WorkerIndex], TEXT("log")));
+		for (const FString& Asset : Manifest.Assets)
+		{
+			MergedResult.Failed.Add(Asset, Reason);
+		}
+	}
+
+	for (const TPair<FString, FString>& Pair : MergedResult.Failed)
+	{
+		UE_LOG(LogRetargetSkeleton, Warning, TEXT("Failed to retarget %s: %s"), *Pair.Key, *Pair.Value);
+	}
+
+	// whatever this editor had loaded is stale now
+	TArray<UPackage*> PackagesToReload;
+	for (const FString& Asset : MergedResult.Retargeted)
+	{
+		if (UObject* LoadedAsset = FindObject<UObject>(nullptr, *Asset))
+		{
+			PackagesToReload.AddUnique(LoadedAsset->GetOutermost());
+		}
+	}
+	if (PackagesToReload.Num() > 0)
+	{
+		UPackageTools::ReloadPackages(PackagesToReload);
+	}
+
+	// workers never save the target skeleton, skeleton wide stages run once here from what they report
+	TSet<FName> CurveNames;
+	for (const FString& CurveName : MergedResult.CurveNames)
+	{
+		CurveNames.Add(FName(*CurveName));
+	}
+	RetargetBatchStages::AddCurveNamesToSkeleton(TargetSkeleton, USkeleton::AnimCurveMappingName, CurveNames);
+	RetargetBatchStages::TransferSockets(SourceSkeleton, TargetSkeleton);
+	RetargetBatchStages::QueueComponentRefresh(SourceSkeleton);
+
+	FNotificationInfo Notification(FText::Format(
+		LOCTEXT("ShardedRetargetDone", "{0} assets were retargeted to new skeleton {1} by {2} worker processes, {3} failed. See Output for details."),
+		FText::AsNumber(MergedResult.Retargeted.Num()), FText::FromString(Context.TargetMesh->GetName()), FText::AsNumber(Workers.Num()), FText::AsNumber(MergedResult.Failed.Num())));
+	Notification.ExpireDuration = 5.f;
+	FSlateNotificationManager::Get().AddNotification(Notification);
+
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+struct FIKRetargetBatchOperationContext;
+
+/** Work handed to one worker editor process, written as json next to its result file */
+struct FIKRetargetShardManifest
+{
+	FString SourceMesh;
+	FString TargetMesh;
+	FString Retargeter;
+	/** Temporary folder of the shard, only used when not retargeting in place */
+	FString FolderPath;
+	bool bRemapReferencedAssets = true;
+	bool bInPlace = true;
+	/** Object paths of the assets the worker starts its batch from */
+	TArray<FString> Assets;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+};
+
+/** What a worker editor process reports back once its shard is done */
+struct FIKRetargetShardResult
+{
+	/** Object paths retargeted and saved */
+	TArray<FString> Retargeted;
+	/** Object path -> reason, for everything the worker could not retarget or save */
+	TMap<FString, FString> Failed;
+	/** Float curve names the worker added to its copy of the target skeleton, which it never saves */
+	TArray<FString> CurveNames;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	/** Result file written by the worker given the manifest */
+	static FString GetResultFilename(const FString& ManifestFilename);
+};
+
+/**
+ * Splits an IK retarget batch over worker editor processes running on this machine.
+ * Assets are grouped by their registry dependencies so montages, blend spaces and blueprints land in the same shard as
+ * what they reference, then each group goes to the lightest shard. Every worker runs the RetargetSkeletonWorker commandlet
+ * on its shard, saving as it goes, and the coordinator merges the shard results and reloads what it had loaded.
+ */
+class FIKRetargetShardCoordinator
+{
+public:
+	/** Number of worker processes set by RetargetSkeleton.WorkerProcesses, below 2 keeps the batch in this process */
+	static int32 GetNumWorkers();
+
+	/**
+	 * Runs the batch in worker processes
+	 *
+	 * @param	Context		Batch to run, AssetsToRetarget is ignored
+	 * @param	Assets		Registry data of the assets to retarget
+	 * @param	bInPlace	Whether workers retarget the original assets rather than temporary duplicates
+	 * @return	false if the batch should run in this process instead, true once it ran or was cancelled at check-out
+	 */
+	static bool Run(const FIKRetargetBatchOperationContext& Context, const TArray<FAssetData>& Assets, bool bInPlace);
+
+private:
+	/** Splits the assets in at most NumShards shards, keeping assets that depend on each other together */
+	static void BuildShards(const TArray<FAssetData>& Assets, int32 NumShards, TArray<TArray<FAssetData>>& OutShards);
+};
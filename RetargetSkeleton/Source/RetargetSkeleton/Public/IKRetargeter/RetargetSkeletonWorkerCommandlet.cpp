@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RetargetSkeletonWorkerCommandlet.h"
+#include "IKRetargetBatchOperation_Copy.h"
+#include "IKRetargetShardCoordinator.h"
+#include "Retargeter/IKRetargeter.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/Paths.h"
+#include "RetargetBatchStages.h"
+
+URetargetSkeletonWorkerCommandlet::URetargetSkeletonWorkerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URetargetSkeletonWorkerCommandlet::Main(const FString& Params)
+{
+	FString ManifestFilename;
+	FIKRetargetShardManifest Manifest;
+	if (!FParse::Value(*Params, TEXT("Manifest="), ManifestFilename) || !Manifest.Load(ManifestFilename))
+	{
+		UE_LOG(LogRetargetSkeleton, Error, TEXT("RetargetSkeletonWorker needs a readable -Manifest=<shard json>"));
+		return 1;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FIKRetargetBatchOperationContext Context;
+	Context.SourceMesh = LoadObject<USkeletalMesh>(nullptr, *Manifest.SourceMesh);
+	Context.TargetMesh = LoadObject<USkeletalMesh>(nullptr, *Manifest.TargetMesh);
+	Context.IKRetargetAsset = LoadObject<UIKRetargeter>(nullptr, *Manifest.Retargeter);
+	Context.NameRule.FolderPath = Manifest.FolderPath;
+	Context.bRemapReferencedAssets = Manifest.bRemapReferencedAssets;
+
+	FIKRetargetShardResult Result;
+	const FString ResultFilename = FIKRetargetShardResult::GetResultFilename(ManifestFilename);
+	if (!Context.IsValid())
+	{
+		for (const FString& Asset : Manifest.Assets)
+		{
+			Result.Failed.Add(Asset, TEXT("Could not load the source mesh, target mesh or retargeter"));
+		}
+		Result.Save(ResultFilename);
+		return 1;
+	}
+
+	TArray<FAssetData> AssetsToLoad;
+	for (const FString& Asset : Manifest.Assets)
+	{
+		const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FName(*Asset));
+		if (AssetData.IsValid())
+		{
+			AssetsToLoad.Add(AssetData);
+		}
+		else
+		{
+			Result.Failed.Add(Asset, TEXT("Not found in the asset registry"));
+		}
+	}
+
+	// the target skeleton is never saved here, the coordinator adds the curve names this shard registers on it
+	TSet<FName> CurveNamesBefore;
+	USkeleton* TargetSkeleton = Context.TargetMesh->GetSkeleton();
+	if (const FSmartNameMapping* CurveMapping = TargetSkeleton->GetSmartNameContainer(USkeleton::AnimCurveMappingName))
+	{
+		TArray<FName> CurveNames;
+		CurveMapping->FillNameArray(CurveNames);
+		CurveNamesBefore.Append(CurveNames);
+	}
+
+	FIKRetargetBatchOperation_Copy BatchOperation;
+	BatchOperation.bInPlace = Manifest.bInPlace;
+	BatchOperation.bSavePages = true;
+	BatchOperation.BatchTag = FPaths::GetBaseFilename(ManifestFilename);
+	BatchOperation.RunRetarget(Context, AssetsToLoad);
+
+	// pages unload what they saved, anything still loaded and dirty failed to save
+	const TSet<FName>& ProcessedAssets = BatchOperation.GetProcessedAssets();
+	for (const FName& ObjectPath : ProcessedAssets)
+	{
+		const UObject* Asset = FindObject<UObject>(nullptr, *ObjectPath.ToString());
+		if (Asset && Asset->GetOutermost()->IsDirty())
+		{
+			Result.Failed.Add(ObjectPath.ToString(), TEXT("Retargeted but not saved"));
+		}
+		else
+		{
+			Result.Retargeted.Add(ObjectPath.ToString());
+		}
+	}
+
+	if (const FSmartNameMapping* CurveMapping = TargetSkeleton->GetSmartNameContainer(USkeleton::AnimCurveMappingName))
+	{
+		TArray<FName> CurveNamesAfter;
+		CurveMapping->FillNameArray(CurveNamesAfter);
+		for (const FName& CurveName : CurveNamesAfter)
+		{
+			if (!CurveNamesBefore.Contains(CurveName))
+			{
+				Result.CurveNames.Add(CurveName.ToString());
+			}
+		}
+	}
+
+	for (const FAssetData& AssetData : AssetsToLoad)
+	{
+		if (!ProcessedAssets.Contains(AssetData.ObjectPath))
+		{
+			Result.Failed.Add(AssetData.ObjectPath.ToString(), TEXT("Not retargeted, see the worker log"));
+		}
+	}
+
+	if (!Result.Save(ResultFilename))
+	{
+		UE_LOG(LogRetargetSkeleton, Error, TEXT("Failed to write retarget shard result %s"), *ResultFilename);
+		return 1;
+	}
+
+	UE_LOG(LogRetargetSkeleton, Display, TEXT("Retarget shard %s: %d retargeted, %d failed"), *ManifestFilename, Result.Retargeted.Num(), Result.Failed.Num());
+	return Result.Failed.Num() == 0 ? 0 : 1;
+}
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RetargetSkeletonWorkerCommandlet.generated.h"
+
+/**
+ * Worker side of a multi-process IK retarget batch, started by FIKRetargetShardCoordinator.
+ * Retargets and saves the assets of one shard manifest, then writes the shard result next to it.
+ *
+ * Usage: -run=RetargetSkeletonWorker -Manifest=<shard json>
+ */
+UCLASS()
+class URetargetSkeletonWorkerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URetargetSkeletonWorkerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
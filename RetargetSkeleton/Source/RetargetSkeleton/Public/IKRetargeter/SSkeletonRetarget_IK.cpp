@@ -19,6 +19,12 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "IKRetargetBatchOperation_Copy.h"
+#include "IKRetargetShardCoordinator.h"
+#include "IKRetargetBatchPlanner.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/Paths.h"
+#include "RetargetBatchStages.h"
+#include "RetargetAssetIndex.h"
 
 #define LOCTEXT_NAMESPACE "SIKRetargetSkel_PoseViewport"
 
@@ -310,6 +316,73 @@ void SSIKRetargetSkel_AnimAssetsWindow::Construct(const FArguments& InArgs)
 				]
 			]
 			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Fill)
+			.Padding(2)
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SSIKRetargetSkel_AnimAssetsWindow::IsRetargetingInPlace)
+				.OnCheckStateChanged(this, &SSIKRetargetSkel_AnimAssetsWindow::OnRetargetInPlaceChanged)
+				.ToolTipText(LOCTEXT("RetargetInPlace_Tooltip", "Retarget the original assets from in-memory snapshots instead of duplicating them into a temporary folder"))
+				[
+					SNew(STextBlock).Text(LOCTEXT("RetargetInPlace", "Retarget In Place"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Fill)
+			.Padding(2)
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SSIKRetargetSkel_AnimAssetsWindow::IsSavingPages)
+				.OnCheckStateChanged(this, &SSIKRetargetSkel_AnimAssetsWindow::OnSavePagesChanged)
+				.ToolTipText(LOCTEXT("SavePages_Tooltip", "Save and unload the retargeted assets every RetargetSkeleton.PageSize assets, whatever the size of the batch. When unchecked the whole batch stays loaded for you to save, unless a RetargetSkeleton memory budget is set."))
+				[
+					SNew(STextBlock).Text(LOCTEXT("SavePages", "Save As It Goes"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.Padding(5)
+			.AutoHeight()
+			[
+				SNew(SSeparator)
+				.Orientation(Orient_Horizontal)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Fill)
+			.Padding(2)
+			[
+				SNew(STextBlock)
+				.Text(this, &SSIKRetargetSkel_AnimAssetsWindow::GetAdditionalTargetsText)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Fill)
+			.Padding(2)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0, 0, 2, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("AddTarget", "Add Target"))
+					.ToolTipText(LOCTEXT("AddTarget_Tooltip", "Also retarget copies of the assets to the current target mesh and retargeter. Pick another retargeter afterwards, every source frame is evaluated once for all targets."))
+					.IsEnabled(this, &SSIKRetargetSkel_AnimAssetsWindow::CanAddTarget)
+					.OnClicked(this, &SSIKRetargetSkel_AnimAssetsWindow::OnAddTarget)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("ClearTargets", "Clear Targets"))
+					.IsEnabled_Lambda([this]() { return AdditionalTargets.Num() > 0; })
+					.OnClicked(this, &SSIKRetargetSkel_AnimAssetsWindow::OnClearTargets)
+				]
+			]
+			+ SVerticalBox::Slot()
 			.HAlign(HAlign_Right)
 			.VAlign(VAlign_Bottom)
 			.Padding(2)
@@ -326,6 +399,15 @@ void SSIKRetargetSkel_AnimAssetsWindow::Construct(const FArguments& InArgs)
 					.OnClicked(this, &SSIKRetargetSkel_AnimAssetsWindow::OnCancel)
 				]
 				+ SUniformGridPanel::Slot(1, 0)
+				[
+					SNew(SButton).HAlign(HAlign_Center)
+					.Text(LOCTEXT("RetargetOptions_Plan", "Plan..."))
+					.ToolTipText(LOCTEXT("RetargetOptions_Plan_Tooltip", "Estimate the time, memory and assets the retarget will take, from asset registry data only"))
+					.IsEnabled(this, &SSIKRetargetSkel_AnimAssetsWindow::CanApply)
+					.OnClicked(this, &SSIKRetargetSkel_AnimAssetsWindow::OnPlan)
+					.ContentPadding(FEditorStyle::GetMargin("StandardDialog.ContentPadding"))
+				]
+				+ SUniformGridPanel::Slot(2, 0)
 				[
 					SNew(SButton).HAlign(HAlign_Center)
 					.Text(LOCTEXT("RetargetOptions_Apply", "Retarget"))
@@ -349,8 +431,57 @@ FReply SSIKRetargetSkel_AnimAssetsWindow::OnApply()
 {
 	UpdateTempFolder();
 	CloseWindow();
+
+	// additional targets must be driven by the batch source, their retargeters were picked independently
+	// the batch target itself is retargeted in place or into the duplicates, never copied a second time
+	const USkeleton* SourceSkeleton = BatchContext.SourceMesh->GetSkeleton();
+	const USkeletalMesh* BatchTargetMesh = BatchContext.TargetMesh;
+	AdditionalTargets.RemoveAll([SourceSkeleton, BatchTargetMesh](const FIKRetargetAdditionalTarget& Target)
+	{
+		if (Target.TargetMesh == BatchTargetMesh)
+		{
+			UE_LOG(LogRetargetSkeleton, Warning, TEXT("Skipping additional target %s, it is the batch target."), *Target.TargetMesh->GetName());
+			return true;
+		}
+
+		const UIKRigDefinition* SourceIKRig = Target.IKRetargetAsset->GetSourceIKRig();
+		const USkeletalMesh* PreviewMesh = SourceIKRig ? SourceIKRig->GetPreviewMesh() : nullptr;
+		if (!PreviewMesh || PreviewMesh->GetSkeleton() != SourceSkeleton)
+		{
+			UE_LOG(LogRetargetSkeleton, Warning, TEXT("Skipping additional target %s, retargeter %s does not use the batch source skeleton."),
+				*Target.TargetMesh->GetName(), *Target.IKRetargetAsset->GetName());
+			return true;
+		}
+		return false;
+	});
+
+	// large batches can be split over worker editor processes, see RetargetSkeleton.WorkerProcesses
+	if (AdditionalTargets.Num() == 0 && FIKRetargetShardCoordinator::Run(BatchContext, RelativeAnimAssets, bRetargetInPlace))
+	{
+		return FReply::Handled();
+	}
+
 	FIKRetargetBatchOperation_Copy BatchOperation;
-	BatchOperation.RunRetarget(BatchContext);
+	BatchOperation.bInPlace = bRetargetInPlace;
+	BatchOperation.bSavePages = bSavePages;
+	BatchOperation.AdditionalTargets = AdditionalTargets;
+	BatchOperation.RunRetarget(BatchContext, RelativeAnimAssets);
+	return FReply::Handled();
+}
+
+FReply SSIKRetargetSkel_AnimAssetsWindow::OnPlan()
+{
+	const FIKRetargetBatchPlan Plan = FIKRetargetBatchPlanner::Plan(BatchContext, RelativeAnimAssets, AdditionalTargets.Num());
+
+	const FString CsvFilename = FPaths::ProjectSavedDir() / TEXT("RetargetSkeleton") / FString::Printf(TEXT("Plan_%s.csv"), *BatchContext.SourceMesh->GetSkeleton()->GetName());
+	FText CsvText;
+	if (Plan.SaveCsv(CsvFilename))
+	{
+		CsvText = FText::Format(LOCTEXT("PlanCsv", "\n\nPer asset details in {0}"), FText::FromString(FPaths::ConvertRelativePathToFull(CsvFilename)));
+	}
+
+	const FText Title = LOCTEXT("PlanTitle", "Retarget Plan");
+	FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("PlanMessage", "{0}{1}"), Plan.GetSummary(), CsvText), &Title);
 	return FReply::Handled();
 }
 
@@ -392,7 +523,7 @@ void SSIKRetargetSkel_AnimAssetsWindow::ShowWindow(USkeleton* InOldSkeleton)
 			SAssignNew(DialogWidget, SSIKRetargetSkel_AnimAssetsWindow)
 		];
 
-	DialogWidget->BatchContext.AssetsToRetarget = FilterRelativeAnimAssets(InOldSkeleton);;
+	DialogWidget->RelativeAnimAssets = FilterRelativeAnimAssets(InOldSkeleton);
 	DialogWindow->SetOnWindowClosed(FRequestDestroyWindowOverride::CreateSP(DialogWidget.Get(), &SSIKRetargetSkel_AnimAssetsWindow::OnDialogClosed));
 	DialogWindow->SetContent(DialogWrapper.ToSharedRef());
 
@@ -456,6 +587,71 @@ void SSIKRetargetSkel_AnimAssetsWindow::OnRemappingReferencedAssetsChanged(EChec
 }
 
 
+ECheckBoxState SSIKRetargetSkel_AnimAssetsWindow::IsRetargetingInPlace() const
+{
+	return bRetargetInPlace ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SSIKRetargetSkel_AnimAssetsWindow::OnRetargetInPlaceChanged(ECheckBoxState InNewRadioState)
+{
+	bRetargetInPlace = (InNewRadioState == ECheckBoxState::Checked);
+}
+
+ECheckBoxState SSIKRetargetSkel_AnimAssetsWindow::IsSavingPages() const
+{
+	return bSavePages ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SSIKRetargetSkel_AnimAssetsWindow::OnSavePagesChanged(ECheckBoxState InNewRadioState)
+{
+	bSavePages = (InNewRadioState == ECheckBoxState::Checked);
+}
+
+bool SSIKRetargetSkel_AnimAssetsWindow::CanAddTarget() const
+{
+	return BatchContext.IsValid();
+}
+
+FReply SSIKRetargetSkel_AnimAssetsWindow::OnAddTarget()
+{
+	const bool bAlreadyAdded = AdditionalTargets.ContainsByPredicate([this](const FIKRetargetAdditionalTarget& Target)
+	{
+		return Target.TargetMesh == BatchContext.TargetMesh;
+	});
+	if (bAlreadyAdded)
+	{
+		return FReply::Handled();
+	}
+
+	// copies go in a folder next to the target mesh, so they never collide with the originals
+	FIKRetargetAdditionalTarget& Target = AdditionalTargets.AddDefaulted_GetRef();
+	Target.TargetMesh = BatchContext.TargetMesh;
+	Target.IKRetargetAsset = BatchContext.IKRetargetAsset;
+	Target.NameRule.FolderPath = FPackageName::GetLongPackagePath(Target.TargetMesh->GetOutermost()->GetName()) / (Target.TargetMesh->GetName() + TEXT("_Animations"));
+	return FReply::Handled();
+}
+
+FReply SSIKRetargetSkel_AnimAssetsWindow::OnClearTargets()
+{
+	AdditionalTargets.Reset();
+	return FReply::Handled();
+}
+
+FText SSIKRetargetSkel_AnimAssetsWindow::GetAdditionalTargetsText() const
+{
+	if (AdditionalTargets.Num() == 0)
+	{
+		return LOCTEXT("NoAdditionalTargets", "No additional targets");
+	}
+
+	FString TargetNames;
+	for (const FIKRetargetAdditionalTarget& Target : AdditionalTargets)
+	{
+		TargetNames += FString::Printf(TEXT("\n%s (%s)"), *Target.TargetMesh->GetName(), *Target.IKRetargetAsset->GetName());
+	}
+	return FText::Format(LOCTEXT("AdditionalTargets", "Additional targets:{0}"), FText::FromString(TargetNames));
+}
+
 void SSIKRetargetSkel_AnimAssetsWindow::UpdateTempFolder()
 {
 	//TODO:get current path + /TempRetargetFolder/
@@ -463,44 +659,21 @@ void SSIKRetargetSkel_AnimAssetsWindow::UpdateTempFolder()
 }
 
 
-TArray<TWeakObjectPtr<UObject>> SSIKRetargetSkel_AnimAssetsWindow::FilterRelativeAnimAssets(USkeleton* InSkel)
+TArray<FAssetData> SSIKRetargetSkel_AnimAssetsWindow::FilterRelativeAnimAssets(USkeleton* InSkel)
 {
 	TArray<FName> Packages;
-	TArray<TWeakObjectPtr<UObject>> RemapData;
+	TArray<FAssetData> RemapData;
 
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	AssetRegistryModule.Get().GetReferencers(InSkel->GetOutermost()->GetFName(), Packages);
 
-	FAssetToolsModule& AssetToolsModule = FModuleManager::GetModuleChecked<FAssetToolsModule>("AssetTools");
 	for (FName PackName : Packages)
 	{
-		const FString PackageName = PackName.ToString();
-		// load package
-		UPackage* Package = LoadPackage(NULL, *PackageName, LOAD_None);
-		if (!Package)
-		{
-			continue;
-		}
-		// get all the objects
-		TArray<UObject*> Objects;
-		GetObjectsWithOuter(Package, Objects);
-
-		// see if we have skeletalmesh
-		bool bSkeletalMeshPackage = false;
-		for (auto Iter = Objects.CreateIterator(); Iter; ++Iter)
+		// classify from the registry, skeletal meshes and unrelated referencers are never loaded
+		FAssetData AssetData;
+		if (FRetargetAssetIndex::ClassifyReferencer(PackName, AssetData) == ERetargetReferencerKind::Animation)
 		{
-			// we only care animation asset or animation blueprint
-			if ((*Iter)->GetClass()->IsChildOf(UAnimationAsset::StaticClass()) ||
-				(*Iter)->GetClass()->IsChildOf(UAnimBlueprint::StaticClass()))
-			{
-				// add to asset 
-				RemapData.Add(*Iter);
-				break;
-			}
-			else if ((*Iter)->GetClass()->IsChildOf(USkeletalMesh::StaticClass()))
-			{
-				break;
-			}
+			RemapData.Add(AssetData);
 		}
 	}
 	return RemapData;
@@ -8,6 +8,7 @@
 #include "PreviewScene.h"
 #include "PropertyCustomizationHelpers.h"
 #include "IKRigEditor/Public/RetargetEditor/IKRetargetBatchOperation.h"
+#include "IKRetargetBatchOperation_Copy.h"
 
 class UIKRetargeter;
 
@@ -143,6 +144,7 @@ private:
 	/** Retarget or Cancel buttons */
 	bool CanApply() const;
 	FReply OnApply();
+	FReply OnPlan();
 	FReply OnCancel();
 	void CloseWindow();
 
@@ -164,15 +166,42 @@ private:
 	/** Modifying "Remap Assets" checkbox */
 	ECheckBoxState IsRemappingReferencedAssets() const;
 	void OnRemappingReferencedAssetsChanged(ECheckBoxState InNewRadioState);
+
+	/** Modifying "Retarget In Place" checkbox */
+	ECheckBoxState IsRetargetingInPlace() const;
+	void OnRetargetInPlaceChanged(ECheckBoxState InNewRadioState);
+
+	/** Modifying "Save As It Goes" checkbox */
+	ECheckBoxState IsSavingPages() const;
+	void OnSavePagesChanged(ECheckBoxState InNewRadioState);
 	
+	/** Additional targets, retargeted into copies in the same pass */
+	bool CanAddTarget() const;
+	FReply OnAddTarget();
+	FReply OnClearTargets();
+	FText GetAdditionalTargetsText() const;
+
 	void UpdateTempFolder();
 
-	static TArray<TWeakObjectPtr<UObject>> FilterRelativeAnimAssets(USkeleton* InSkel);
+	/** Registry data of the animation assets and blueprints referencing the skeleton, nothing is loaded */
+	static TArray<FAssetData> FilterRelativeAnimAssets(USkeleton* InSkel);
 
 private:
 	/** Necessary data collected from UI to run retarget. */
 	FIKRetargetBatchOperationContext BatchContext;
 
+	/** Assets to retarget, loaded page by page once the retarget runs */
+	TArray<FAssetData> RelativeAnimAssets;
+
+	/** Retarget the original assets without duplicating them into a temporary folder first */
+	bool bRetargetInPlace = true;
+
+	/** Save and unload the batch page by page instead of leaving it loaded for the user to save */
+	bool bSavePages = false;
+
+	/** Targets retargeted into new assets next to their mesh, evaluating the source animation once for all of them */
+	TArray<FIKRetargetAdditionalTarget> AdditionalTargets;
+
 	/** Pool for maintaining and rendering thumbnails */
 	TSharedPtr<FAssetThumbnailPool> AssetThumbnailPool;
 
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+/** What a package referencing a skeleton holds, as far as retargeting is concerned */
+enum class ERetargetReferencerKind : uint8
+{
+	/** Animation asset or animation blueprint, needs retargeting */
+	Animation,
+	/** Skeletal mesh, silently ignored by retargeting */
+	SkeletalMesh,
+	/** Nothing retargeting knows about */
+	Unrelated,
+};
+
+/**
+ * Asset registry backed lookups used by the retarget dialogs.
+ * The index is built lazily on first use and kept up to date from registry events,
+ * so the pickers can filter rows without loading assets or comparing tag strings.
+ */
+class FRetargetAssetIndex
+{
+public:
+	static FRetargetAssetIndex& Get();
+
+	/** Unregisters from the asset registry and releases the index, called on module shutdown */
+	static void Shutdown();
+
+	~FRetargetAssetIndex();
+
+	/** Name used as key for a rig, matches the value stored in USkeleton::RigTag */
+	static FName GetRigKey(const FString& RigFullName);
+
+	/** Returns the rig key the skeleton was saved with, NAME_None if unknown or no rig */
+	FName GetSkeletonRig(FName SkeletonObjectPath);
+
+	/** Name used as key for a skeleton, matches the "Skeleton" tag written by animation assets */
+	static FName GetSkeletonKey(const class USkeleton* Skeleton);
+
+	/** Gathers registry data of all animation assets saved against the given skeleton, resolved through the registry on each call */
+	void GetAnimationAssetsForSkeleton(FName SkeletonKey, TArray<FAssetData>& OutAssets);
+
+	/**
+	 * Classifies a referencing package from the asset registry, without loading it
+	 *
+	 * @param PackageName		Package to classify
+	 * @param OutAssetData		Receives the animation asset or blueprint when the package needs retargeting
+	 */
+	static ERetargetReferencerKind ClassifyReferencer(FName PackageName, FAssetData& OutAssetData);
+
+private:
+	FRetargetAssetIndex() = default;
+
+	void BuildIfNeeded();
+
+	void AddSkeleton(const FAssetData& AssetData);
+	void RemoveSkeleton(FName SkeletonObjectPath);
+
+	void AddAnimationAsset(const FAssetData& AssetData);
+	void RemoveAnimationAsset(FName AssetObjectPath);
+
+	static bool IsAnimationAsset(const FAssetData& AssetData);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+
+	bool bBuilt = false;
+
+	/** Skeleton object path -> rig key */
+	TMap<FName, FName> SkeletonToRig;
+
+	/** Skeleton key -> animation asset object paths, the registry holds the asset data */
+	TMap<FName, TSet<FName>> SkeletonToAnimationAssets;
+	/** Animation asset object path -> skeleton key */
+	TMap<FName, FName> AnimationAssetToSkeleton;
+
+	FDelegateHandle OnAssetAddedHandle;
+	FDelegateHandle OnAssetRemovedHandle;
+	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnAssetUpdatedHandle;
+
+	static TUniquePtr<FRetargetAssetIndex> Instance;
+};
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogRetargetSkeleton, Log, All);
+
+class UPackage;
+class USkeleton;
+class UAnimationAsset;
+class UAnimBlueprint;
+class UAnimSequence;
+
+/**
+ * Stages shared by the skeleton retarget flows.
+ * Each stage runs once over the whole batch instead of once per asset.
+ */
+namespace RetargetBatchStages
+{
+	/**
+	 * Memory budget of a batch, from RetargetSkeleton.FlushEveryAssets and RetargetSkeleton.FlushAboveResidentMB.
+	 * When enabled, batches save what they retargeted, unload it and collect garbage before going on.
+	 */
+	struct FMemoryBudget
+	{
+		/** Flush after this many assets, 0 for no limit */
+		int32 FlushEveryAssets = 0;
+		/** Flush once the process uses more physical memory than this, 0 for no limit */
+		uint64 FlushAboveResidentBytes = 0;
+		/** Assets taken before the resident limit can end a flush interval early */
+		int32 MinAssetsBeforeFlush = 1;
+
+		static FMemoryBudget FromConsoleVariables();
+
+		bool IsEnabled() const { return FlushEveryAssets > 0 || FlushAboveResidentBytes > 0; }
+
+		/** Number of assets to take before flushing, DefaultCount when only the resident limit is set */
+		int32 GetFlushInterval(int32 DefaultCount) const { return FlushEveryAssets > 0 ? FlushEveryAssets : DefaultCount; }
+
+		bool IsOverResidentLimit() const;
+	};
+
+	/**
+	 * Unloads the given packages once they are saved and collects garbage.
+	 * Dirty packages and packages holding anim blueprints stay loaded.
+	 *
+	 * @return	Number of packages unloaded
+	 */
+	int32 ReleasePackages(const TArray<UPackage*>& Packages);
+
+	/**
+	 * Saves the given packages without prompting, the packages must already be checked out or writable.
+	 * Serialization happens on the game thread but file writes are asynchronous, so they overlap with the next package.
+	 * Packages written for the first time are marked for add when source control is enabled.
+	 *
+	 * @param	Packages			Packages to save
+	 * @param	OutFailedPackages	Optionally receives the packages that could not be saved
+	 * @return	true if every package was saved
+	 */
+	bool SavePackages(const TArray<UPackage*>& Packages, TArray<UPackage*>* OutFailedPackages = nullptr);
+
+	/**
+	 * Registers the given curve names on the skeleton, the ones it is missing are added in a single update.
+	 *
+	 * @param	ContainerName	Smart name container, such as USkeleton::AnimCurveMappingName
+	 * @return	Number of names added
+	 */
+	int32 AddCurveNamesToSkeleton(USkeleton* Skeleton, const FName& ContainerName, const TSet<FName>& CurveNames);
+
+	/**
+	 * Registers the curve names used by the given assets on the new skeleton.
+	 * Names are gathered across the whole batch first, so the skeleton is modified once per curve container
+	 * instead of once per asset and curve type. The curves of each sequence then take their UIDs from the new skeleton,
+	 * call it while the sequences are bracketed to avoid notifying each one twice.
+	 *
+	 * @param	OldSkeleton					Skeleton the assets were authored against, nothing is done when it is the new skeleton
+	 * @param	NewSkeleton					Skeleton receiving the curve names
+	 * @param	AnimAssets					Assets being retargeted, anything that isn't a sequence is skipped
+	 * @param	bIncludeTransformCurves		Whether transform curve names of anim sequences are copied as well
+	 */
+	void CopyCurveNamesToSkeleton(USkeleton* OldSkeleton, USkeleton* NewSkeleton, const TArray<UAnimationAsset*>& AnimAssets, bool bIncludeTransformCurves);
+
+	/**
+	 * Copies the sockets of the old skeleton that are missing on the new one and whose bone exists there.
+	 * Virtual bones are copied too when RetargetSkeleton.TransferVirtualBones is set.
+	 * The new skeleton is modified and dirtied once for the whole transfer.
+	 *
+	 * @param	OldSkeleton		Skeleton to copy from
+	 * @param	NewSkeleton		Skeleton to copy to
+	 * @param	bDryRun			Only log what would be transferred, without touching the new skeleton
+	 * @return	Number of sockets and virtual bones transferred, or that would be in a dry run
+	 */
+	int32 TransferSockets(const USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bDryRun = false);
+
+	/**
+	 * Refreshes and compiles the given anim blueprints, parents before children and each one once.
+	 * Garbage collection is skipped, callers collect once at the end of their batch.
+	 *
+	 * @param	AnimBlueprints	Blueprints to compile, duplicates and nulls are ignored
+	 * @return	Number of blueprints compiled
+	 */
+	int32 CompileAnimBlueprints(const TArray<UAnimBlueprint*>& AnimBlueprints);
+
+	/**
+	 * Ends the batch edit of the given sequences and compresses each of them once.
+	 * Every sequence must still hold the controller bracket opened for its edit, so its data model has not notified
+	 * anything yet and nothing was compressed. The brackets are closed back to back, each sending its sequence the single
+	 * notification that requests compression from the derived data cache, then all requests are waited on together.
+	 *
+	 * @param	Sequences	Sequences whose edit bracket is still open
+	 */
+	void CompressAnimSequences(const TArray<UAnimSequence*>& Sequences);
+
+	/**
+	 * Queues re-initialization of the anim instances of every skeletal mesh component using the given skeleton.
+	 * The refresh runs on the next editor tick, so all skeletons retargeted by one selection share a single
+	 * pass over the loaded components.
+	 */
+	void QueueComponentRefresh(USkeleton* Skeleton);
+
+	/** Drops any queued component refresh, called on module shutdown */
+	void CancelComponentRefresh();
+}
@@ -1,61 +1,99 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "ReferenceSkeleton.h"
-
-//////////////////////////////////////////////////////////////////////////
-// FBoneDescription
-//////////////////////////////////////////////////////////////////////////
-struct FRigBoneDescription
-{
-	FMeshBoneInfo BoneInfo;
-
-	FVector NormalizedPosition; // based on whole mesh size
-	FVector DirFromParent;
-	FVector DirFromRoot;
-	float	RatioFromParent; // based on whole mesh size
-	int32	NumChildren;
-
-	TArray<float> Scores;
-
-	void ResetScore(int32 NewCount)
-	{
-		Scores.Reset(NewCount);
-		Scores.AddZeroed(NewCount);
-	}
-
-	void SetScore(int32 Index, float NewScore)
-	{
-		Scores[Index] = NewScore;
-	}
-
-	float GetScore(int32 Index) const
-	{
-		return Scores[Index];
-	}
-
-	float CalculateScore(const FRigBoneDescription& Other) const;
-	float CalculateNameScore(const FName& Name1, const FName& Name2) const;
-	int32 GetBestIndex() const;
-};
-
-//////////////////////////////////////////////////////////////////////////
-// BoneMappingHelper Class
-struct FRigBoneMappingHelper
-{
-	// input - 2 skeletons
-	FReferenceSkeleton RefSkeleton[2];
-
-	// initialize data
-	FRigBoneMappingHelper(const FReferenceSkeleton& InRefSkeleton1, const FReferenceSkeleton& InRefSkeleton2);
-
-	void TryMatch(TMap<FName, FName>& OutBestMatches);
-
-private:
-	// BoneDescription array for each bone
-	TArray<FRigBoneDescription>	BoneDescs[2];
-
-	void Initialize(int32 Index, const FReferenceSkeleton& InRefSkeleton);
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReferenceSkeleton.h"
+
+//////////////////////////////////////////////////////////////////////////
+// FBoneDescription
+//////////////////////////////////////////////////////////////////////////
+struct FRigBoneDescription
+{
+	FMeshBoneInfo BoneInfo;
+
+	FVector NormalizedPosition; // based on whole mesh size
+	FVector DirFromParent;
+	FVector DirFromRoot;
+	float	RatioFromParent; // based on whole mesh size
+	int32	NumChildren;
+
+	float CalculateScore(const FRigBoneDescription& Other) const;
+	float CalculateNameScore(const FName& Name1, const FName& Name2) const;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// FRigBoneScoreMatrix
+//////////////////////////////////////////////////////////////////////////
+
+/** How the score matrix between two skeletons is stored */
+enum class ERigBoneScoreStorage : uint8
+{
+	/** Pick Full for small skeleton pairs, TopK once the matrix gets large */
+	Auto,
+	/** One float per bone pair */
+	Full,
+	/** Only the best K scores of each row */
+	TopK,
+};
+
+/**
+ * Single contiguous row-major score matrix (rows = bones of the first skeleton, columns = bones of the second).
+ * Scores are expected to be in [0, 1].
+ */
+struct FRigBoneScoreMatrix
+{
+	void Reset(int32 InNumRows, int32 InNumColumns, ERigBoneScoreStorage InStorage, int32 InTopK);
+
+	void SetScore(int32 Row, int32 Column, float Score);
+
+	/** returns 0 for entries that are not stored (TopK) */
+	float GetScore(int32 Row, int32 Column) const;
+
+	/**
+	 * Collects up to MaxCount columns with a positive score for the row, best first.
+	 * Ties keep the lowest column first.
+	 */
+	void GetBestColumns(int32 Row, int32 MaxCount, TArray<TPair<int32, float>>& OutColumns) const;
+
+	ERigBoneScoreStorage GetStorage() const { return Storage; }
+	SIZE_T GetAllocatedSize() const;
+
+	/** Storage picked by Auto for a NumRows x NumColumns matrix */
+	static ERigBoneScoreStorage ResolveStorage(ERigBoneScoreStorage InStorage, int32 InNumRows, int32 InNumColumns);
+
+private:
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 TopK = 0;
+	ERigBoneScoreStorage Storage = ERigBoneScoreStorage::Full;
+
+	// Full
+	TArray<float> Scores;
+	// TopK - NumRows * TopK slots sorted by score, INDEX_NONE for empty slots
+	TArray<int32> TopKColumns;
+	TArray<float> TopKScores;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// BoneMappingHelper Class
+struct FRigBoneMappingHelper
+{
+	// input - 2 skeletons
+	FReferenceSkeleton RefSkeleton[2];
+
+	// initialize data
+	FRigBoneMappingHelper(const FReferenceSkeleton& InRefSkeleton1, const FReferenceSkeleton& InRefSkeleton2, ERigBoneScoreStorage InScoreStorage = ERigBoneScoreStorage::Auto);
+
+	void TryMatch(TMap<FName, FName>& OutBestMatches);
+
+private:
+	// BoneDescription array for each bone
+	TArray<FRigBoneDescription>	BoneDescs[2];
+
+	// scores of BoneDescs[0] (rows) against BoneDescs[1] (columns)
+	FRigBoneScoreMatrix ScoreMatrix;
+	ERigBoneScoreStorage ScoreStorage;
+
+	void Initialize(int32 Index, const FReferenceSkeleton& InRefSkeleton);
+};
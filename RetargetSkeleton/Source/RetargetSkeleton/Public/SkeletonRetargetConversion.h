@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkeleton;
+class UAnimationAsset;
+
+/**
+ * Skeleton replacement for the legacy Rig/BoneMapping retarget flow.
+ */
+namespace SkeletonRetargetConversion
+{
+	/**
+	 * Bone correspondence between two skeletons sharing a rig, resolved once per skeleton pair
+	 * so per-asset conversion never goes through rig node names.
+	 */
+	struct FRigBoneTranslationTable
+	{
+		/** Old bone index for each new bone, INDEX_NONE when the bone is not mapped by the rig */
+		TArray<int32> NewToOldBone;
+		/** Retarget base pose of each mapped new bone relative to its old bone, in component space */
+		TArray<FTransform> NewRelativeToOld;
+
+		/** Resolves every rig node to a bone on both skeletons, both must use the same rig */
+		static FRigBoneTranslationTable Build(const USkeleton* OldSkeleton, const USkeleton* NewSkeleton);
+	};
+
+	/**
+	 * Replaces the skeleton of the given animation assets.
+	 * When spaces are converted and both skeletons share a rig, the bone tracks of every sequence are converted on
+	 * worker threads into staging buffers and written back on the game thread afterwards.
+	 * Anything else goes through UAnimationAsset::ReplaceSkeleton.
+	 *
+	 * @param	AnimAssets		Assets to move to the new skeleton
+	 * @param	OldSkeleton		Skeleton the assets currently use
+	 * @param	NewSkeleton		Skeleton to move to
+	 * @param	bConvertSpaces	Whether animation data should be converted to the new skeleton's bone spaces
+	 */
+	void ReplaceSkeleton(const TArray<UAnimationAsset*>& AnimAssets, USkeleton* OldSkeleton, USkeleton* NewSkeleton, bool bConvertSpaces);
+}